@@ -0,0 +1,103 @@
+// bench_oscwave.cpp
+//
+// Compares the cube renderer's AmpMod oscillator paths on the host:
+// • reference: float phase, floorf() wrap and the per-waveform switch with
+//   sinf() for Sine, as step() did before the wavetables;
+// • wavetable: 32-bit phase accumulator and waveLookup() on the tables
+//   initialise() builds in the shared DRAM region.
+//
+// Includes noculling.cpp directly so the static tables and helpers are visible.
+// Cycles are NT_getCpuCycleCount() ticks (the TSC on x86 hosts).
+
+#include "nt_host.h"
+#include "plugins/sequencer_v1/noculling.cpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+static float referenceOscWave(int type, float phase) {
+    phase -= floorf(phase);
+    switch (type) {
+        case 0: // Square
+            return (phase < 0.5f) ? 1.0f : -1.0f;
+        case 1: // Triangle
+            return (phase < 0.5f) ? (4.0f*phase-1.0f) : (3.0f-4.0f*phase);
+        case 2: // Saw
+            return 1.0f - 2.0f*phase;
+        case 3: // Ramp
+            return 2.0f*phase - 1.0f;
+        case 4: // Sine
+        default:
+            return sinf(2.0f * 3.14159265f * phase);
+    }
+}
+
+// Out-of-line so the wave type is not constant-folded into the loop, matching
+// how step() used to call it.
+__attribute__((noinline))
+static float runReference(int type, float inc, float offset, int n) {
+    float phase = 0.0f, sum = 0.0f;
+    for (int i = 0; i < n; ++i) {
+        phase += inc;
+        if (phase >= 1.0f) phase -= floorf(phase);
+        sum += referenceOscWave(type, phase + offset);
+    }
+    return sum;
+}
+
+__attribute__((noinline))
+static float runWavetable(const float* table, uint32_t inc, uint32_t offset, int n) {
+    uint32_t phase = 0;
+    float sum = 0.0f;
+    for (int i = 0; i < n; ++i) {
+        phase += inc;
+        sum += waveLookup(table, phase + offset);
+    }
+    return sum;
+}
+
+int main(int argc, char** argv) {
+    int n = (argc > 1) ? std::atoi(argv[1]) : 1 << 22;
+    const float fs = 48000.0f, freq = 1234.5f;
+    const float inc = freq / fs;
+    const uint32_t incQ = static_cast<uint32_t>(static_cast<int64_t>(inc * 4294967296.0f));
+
+    NT_hostConfigure(48000, 128);
+    _NT_staticRequirements req;
+    calculateStaticRequirements(req);
+    std::vector<uint8_t> dram(req.dram);
+    _NT_staticMemoryPtrs ptrs = { dram.data() };
+    initialise(ptrs, req);
+
+    std::printf("%d samples at %.1f Hz / %.0f Hz, %d-point tables, %d harmonics\n",
+                n, freq, fs, kWaveTableSize, kWaveHarmonics);
+    std::printf("%-9s %12s %12s %9s %11s\n", "wave", "ref cyc/smp", "table cyc/smp", "speedup", "max |err|");
+
+    volatile float sink = 0.0f;
+    for (int w = 0; w < kNumWaves; ++w) {
+        const float* table = sharedWaves + w * kWaveTableStride;
+
+        uint32_t t0 = NT_getCpuCycleCount();
+        sink = sink + runReference(w, inc, 0.0f, n);
+        uint32_t t1 = NT_getCpuCycleCount();
+        sink = sink + runWavetable(table, incQ, 0, n);
+        uint32_t t2 = NT_getCpuCycleCount();
+
+        // Deviation from the naive shape; large for the discontinuous waves
+        // by design, since the tables are band-limited.
+        float maxErr = 0.0f;
+        for (int i = 0; i < 4096; ++i) {
+            float p = static_cast<float>(i) / 4096.0f;
+            uint32_t pq = static_cast<uint32_t>(i) << 20;
+            float e = fabsf(referenceOscWave(w, p) - waveLookup(table, pq));
+            if (e > maxErr) maxErr = e;
+        }
+
+        double refCyc = static_cast<double>(t1 - t0) / n;
+        double tabCyc = static_cast<double>(t2 - t1) / n;
+        std::printf("%-9s %12.2f %12.2f %8.2fx %11.6f\n",
+                    modWaveStrings[w], refCyc, tabCyc, refCyc / tabCyc, maxErr);
+    }
+    return 0;
+}
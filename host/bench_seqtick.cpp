@@ -0,0 +1,133 @@
+// bench_seqtick.cpp
+//
+// Per-tick sequence update cost in the MIDI Pattern Generator:
+// • reference: one struct of ints per sequence, as Plugin held them before
+//   the lanes, updated with the original % wraps;
+// • lanes: advanceLanes() over the byte-wide SeqLanes rows.
+//
+// Both run kSeqs sequences of kSteps steps, the default specifications, with
+// the same settings from the same seed and must produce the same
+// notes. MIDI output and note-off handling are left out so only the state
+// update is timed. The host has no DTC and both layouts fit in L1, so the
+// timings compare loop shape only; they are not a case for the lanes, which
+// are there for footprint (see SeqLanes). On x86 the lanes are somewhat
+// slower.
+//
+// Includes plugin.cpp directly so the static types and helpers are visible.
+
+#include "nt_host.h"
+#include "plugins/MyFirstPlugin/plugin.cpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+static const int kSeqs = 16;
+static const int kSteps = 16;
+
+struct RefSequence {
+    int steps;
+    int div;
+    int range;
+    DirMode dir;
+    int pos;
+    int divCounter;
+    int data[kSteps];
+};
+
+__attribute__((noinline))
+static uint64_t refAdvance(RefSequence* seqs, const bool* includes, Rng& rng, bool randomise, uint8_t* notes) {
+    uint64_t fired = 0;
+    for (int ch = 0; ch < kSeqs; ++ch) {
+        RefSequence& s = seqs[ch];
+        if (++s.divCounter >= s.div) {
+            s.divCounter = 0;
+            int idx = s.pos;
+            if (randomise && includes[ch]) {
+                s.data[idx] = rng.below(s.range + 1);
+            }
+            notes[ch] = s.data[idx];
+            fired |= (uint64_t)1 << ch;
+            if (s.dir == FWD) s.pos = (s.pos + 1) % s.steps;
+            else if (s.dir == BWD) s.pos = (s.pos + s.steps - 1) % s.steps;
+            else if (s.dir == RND) s.pos = rng.below(s.steps);
+        }
+    }
+    return fired;
+}
+
+__attribute__((noinline))
+static uint64_t lanesAdvance(const SeqLanes& lanes, Rng& rng, bool randomise, uint8_t* notes) {
+    return advanceLanes(lanes, rng, randomise, notes);
+}
+
+int main(int argc, char** argv) {
+    int n = (argc > 1) ? std::atoi(argv[1]) : 1 << 21;
+
+    std::printf("%d ticks, %d sequences\n", n, kSeqs);
+    std::printf("%-10s %12s %12s %12s %9s\n", "randomise", "ref ns/tick", "lanes ns/tick", "ref cyc/tick", "ref/lanes");
+
+    for (int randomise = 0; randomise < 2; ++randomise) {
+        static RefSequence seqs[kSeqs];
+        static bool includes[kSeqs];
+        alignas(uint16_t) static uint8_t rows[SeqLanes::rowBytes(kSeqs)];
+        static uint8_t steps[kSeqs * kSteps];
+        SeqLanes lanes;
+        lanes.carve(rows, steps, kSeqs, kSteps);
+        Rng seedRng;
+        seedRng.seed(1);
+        for (int ch = 0; ch < kSeqs; ++ch) {
+            RefSequence& s = seqs[ch];
+            s.steps = 3 + ch % 14;
+            s.div = 1 + ch % 4;
+            s.range = 20 + ch * 6;
+            s.dir = static_cast<DirMode>(ch % 3);
+            s.pos = 0;
+            s.divCounter = 0;
+            includes[ch] = (ch % 4) != 1;
+            for (int j = 0; j < kSteps; ++j) s.data[j] = seedRng.below(128);
+
+            lanes.last[ch] = s.steps - 1;
+            lanes.div[ch] = s.div;
+            lanes.range[ch] = s.range;
+            lanes.dir[ch] = s.dir;
+            lanes.pos[ch] = 0;
+            lanes.divCounter[ch] = 0;
+            lanes.include[ch] = includes[ch];
+            for (int j = 0; j < kSteps; ++j) lanes.data[ch * kSteps + j] = s.data[j];
+        }
+
+        Rng refRng, lanesRng;
+        refRng.seed(7);
+        lanesRng.seed(7);
+        uint8_t refNotes[kSeqs] = {}, lanesNotes[kSeqs] = {};
+        uint32_t refSum = 0, lanesSum = 0;
+
+        auto t0 = std::chrono::steady_clock::now();
+        uint32_t c0 = NT_getCpuCycleCount();
+        for (int i = 0; i < n; ++i) {
+            uint64_t fired = refAdvance(seqs, includes, refRng, randomise, refNotes);
+            refSum = refSum * 31 + (uint32_t)fired + refNotes[i & (kSeqs - 1)];
+        }
+        uint32_t c1 = NT_getCpuCycleCount();
+        auto t1 = std::chrono::steady_clock::now();
+        for (int i = 0; i < n; ++i) {
+            uint64_t fired = lanesAdvance(lanes, lanesRng, randomise, lanesNotes);
+            lanesSum = lanesSum * 31 + (uint32_t)fired + lanesNotes[i & (kSeqs - 1)];
+        }
+        auto t2 = std::chrono::steady_clock::now();
+
+        if (refSum != lanesSum) {
+            std::printf("lanes and reference disagree\n");
+            return 1;
+        }
+        double refNs = std::chrono::duration<double, std::nano>(t1 - t0).count() / n;
+        double lanesNs = std::chrono::duration<double, std::nano>(t2 - t1).count() / n;
+        std::printf("%-10s %12.2f %12.2f %12.1f %8.2fx\n", randomise ? "on" : "off",
+                    refNs, lanesNs, static_cast<double>(c1 - c0) / n, refNs / lanesNs);
+    }
+    std::printf("state: reference %zu bytes, lanes %zu bytes\n",
+                sizeof(RefSequence) * kSeqs + sizeof(bool) * kSeqs,
+                (size_t)kSeqs * (SeqLanes::kNumRows + kSteps));
+    return 0;
+}
@@ -0,0 +1,128 @@
+// nt_bench.cpp
+//
+// Host benchmark driver. Linked against one plug-in and the stand-in runtime,
+// it constructs every factory the plug-in exports, renders a fixed amount of
+// audio through step(), and reports the cost per frame.
+//
+// Usage: bench_<plugin> [-r sampleRate] [-b framesPerStep] [-s seconds]
+//                       [-p param=value]... [-S spec=value]...
+//
+// -p and -S apply to every factory; indices are the plug-in's own.
+
+#include "nt_host.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+struct Assignment { int index; int value; };
+
+static bool parseAssignment( const char* arg, Assignment& out )
+{
+	return std::sscanf( arg, "%d=%d", &out.index, &out.value ) == 2;
+}
+
+static void usage( const char* argv0 )
+{
+	std::fprintf( stderr,
+		"usage: %s [-r sampleRate] [-b framesPerStep] [-s seconds] [-p param=value]... [-S spec=value]...\n",
+		argv0 );
+	std::exit( 2 );
+}
+
+int main( int argc, char** argv )
+{
+	uint32_t sampleRate = 48000;
+	uint32_t framesPerStep = 128;
+	float seconds = 10.0f;
+	std::vector<Assignment> params, specs;
+
+	for ( int i = 1; i < argc; ++i )
+	{
+		const char* a = argv[i];
+		if ( i + 1 >= argc )
+			usage( argv[0] );
+		const char* val = argv[++i];
+		Assignment as;
+		if ( !std::strcmp( a, "-r" ) )
+			sampleRate = std::atoi( val );
+		else if ( !std::strcmp( a, "-b" ) )
+			framesPerStep = std::atoi( val );
+		else if ( !std::strcmp( a, "-s" ) )
+			seconds = (float)std::atof( val );
+		else if ( !std::strcmp( a, "-p" ) && parseAssignment( val, as ) )
+			params.push_back( as );
+		else if ( !std::strcmp( a, "-S" ) && parseAssignment( val, as ) )
+			specs.push_back( as );
+		else
+			usage( argv[0] );
+	}
+	if ( sampleRate == 0 || framesPerStep == 0 || ( framesPerStep & 3 ) || seconds <= 0.0f )
+		usage( argv[0] );
+
+	NT_hostConfigure( sampleRate, framesPerStep );
+
+	int numFactories = NT_hostNumFactories();
+	if ( numFactories <= 0 )
+		return 1;
+
+	std::vector<float> busFrames( kNT_hostNumBusses * framesPerStep );
+	uint64_t numSteps = (uint64_t)( seconds * sampleRate / framesPerStep );
+	if ( numSteps == 0 )
+		numSteps = 1;
+
+	std::printf( "sample rate %u Hz, %u frames per step, %llu steps\n",
+		sampleRate, framesPerStep, (unsigned long long)numSteps );
+
+	for ( int f = 0; f < numFactories; ++f )
+	{
+		const _NT_factory* factory = NT_hostFactory( f );
+		if ( !factory )
+			continue;
+
+		int32_t specValues[kNT_hostMaxSpecifications];
+		for ( uint32_t s = 0; s < factory->numSpecifications && s < (uint32_t)kNT_hostMaxSpecifications; ++s )
+			specValues[s] = factory->specifications[s].def;
+		for ( const Assignment& as : specs )
+			if ( as.index >= 0 && (uint32_t)as.index < factory->numSpecifications )
+				specValues[as.index] = as.value;
+
+		NT_hostInstance inst;
+		if ( !NT_hostConstruct( inst, factory, specValues ) )
+			return 1;
+		for ( const Assignment& as : params )
+			if ( as.index >= 0 && (uint32_t)as.index < inst.req.numParameters )
+				NT_hostSetParameter( inst, as.index, as.value );
+
+		// Warm up caches and branch predictors before timing.
+		for ( int i = 0; i < 64; ++i )
+			NT_hostStep( inst, busFrames.data(), framesPerStep );
+
+		auto t0 = std::chrono::steady_clock::now();
+		for ( uint64_t i = 0; i < numSteps; ++i )
+			NT_hostStep( inst, busFrames.data(), framesPerStep );
+		auto t1 = std::chrono::steady_clock::now();
+
+		double ns = (double)std::chrono::duration_cast<std::chrono::nanoseconds>( t1 - t0 ).count();
+		double frames = (double)numSteps * framesPerStep;
+		double nsPerFrame = ns / frames;
+		double framesPerSecond = frames * 1e9 / ns;
+		double load = 100.0 * sampleRate / framesPerSecond;
+
+		char guid[5];
+		for ( int c = 0; c < 4; ++c )
+			guid[c] = (char)( factory->guid >> ( 8 * c ) );
+		guid[4] = 0;
+
+		std::printf( "%-4s %-28s %9.2f ns/frame %14.0f frames/s %7.3f%% of real time\n",
+			guid, factory->name, nsPerFrame, framesPerSecond, load );
+
+		if ( NT_hostDraw( inst ) && NT_hostDrawnText()[0] )
+			std::printf( "%s", NT_hostDrawnText() );
+
+		NT_hostDestroy( inst );
+	}
+	return 0;
+}
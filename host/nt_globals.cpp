@@ -0,0 +1,27 @@
+// nt_globals.cpp
+//
+// Definition of NT_globals for the host build.
+// api.h declares NT_globals as const, which is right for plug-ins but leaves the
+// host no way to set the sample rate or block size at run time. This file
+// deliberately does not include api.h: it defines the symbol with an identical,
+// writable layout under C linkage, and nt_host.cpp configures it through
+// NT_hostGlobalsStorage().
+
+#include <stdint.h>
+
+struct HostGlobals
+{
+	uint32_t	sampleRate;
+	uint32_t	maxFramesPerStep;
+	float*		workBuffer;
+	uint32_t	workBufferSizeBytes;
+};
+
+extern "C" {
+HostGlobals NT_globals = { 48000, 128, nullptr, 0 };
+}
+
+void* NT_hostGlobalsStorage()
+{
+	return &NT_globals;
+}
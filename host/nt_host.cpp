@@ -0,0 +1,341 @@
+// nt_host.cpp
+//
+// Host-side implementation of the disting NT runtime symbols used by plug-ins.
+// Drawing is reduced to bookkeeping: NT_screen exists and NT_drawText() records
+// its strings, but nothing is rasterised.
+
+#include "nt_host.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+void* NT_hostGlobalsStorage();
+
+static _NT_globals& hostGlobals()
+{
+	return *static_cast<_NT_globals*>( NT_hostGlobalsStorage() );
+}
+
+//—-----------------------------------------------------------------------------------------------
+// Host state
+//—-----------------------------------------------------------------------------------------------
+
+static NT_hostMidiHook	midiHook = nullptr;
+static void*			midiHookUser = nullptr;
+static uint32_t			midiCount = 0;
+
+static NT_hostInstance*	instances[kNT_hostMaxInstances];
+
+static const _NT_factory*	initialisedFactories[16];
+static int					numInitialisedFactories = 0;
+
+static bool		simulatedCycles = false;
+static uint64_t	simulatedCycleFrame = 0;
+
+static char		drawnText[4096];
+static size_t	drawnTextLength = 0;
+
+static void* allocZeroed( uint32_t bytes )
+{
+	// Never hand a plug-in a null pointer, even for a zero-byte request.
+	void* p = std::calloc( 1, bytes ? bytes : 1 );
+	if ( !p )
+	{
+		std::fprintf( stderr, "nt_host: out of memory (%u bytes)\n", bytes );
+		std::exit( 1 );
+	}
+	return p;
+}
+
+//—-----------------------------------------------------------------------------------------------
+// Host control
+//—-----------------------------------------------------------------------------------------------
+
+void NT_hostConfigure( uint32_t sampleRate, uint32_t maxFramesPerStep )
+{
+	_NT_globals& g = hostGlobals();
+	std::free( g.workBuffer );
+	g.sampleRate = sampleRate;
+	g.maxFramesPerStep = maxFramesPerStep;
+	g.workBufferSizeBytes = maxFramesPerStep * kNT_hostNumBusses * sizeof(float);
+	g.workBuffer = static_cast<float*>( allocZeroed( g.workBufferSizeBytes ) );
+}
+
+void NT_hostSetMidiHook( NT_hostMidiHook hook, void* user )
+{
+	midiHook = hook;
+	midiHookUser = user;
+}
+
+uint32_t NT_hostMidiCount()
+{
+	return midiCount;
+}
+
+void NT_hostSetCycleFrame( uint64_t frame )
+{
+	simulatedCycles = true;
+	simulatedCycleFrame = frame;
+}
+
+void NT_hostRealCycleClock()
+{
+	simulatedCycles = false;
+}
+
+int NT_hostNumFactories()
+{
+	uintptr_t version = pluginEntry( kNT_selector_version, 0 );
+	if ( version < kNT_apiVersion4 || version > kNT_apiVersion6 )
+	{
+		std::fprintf( stderr, "nt_host: unsupported API version %u\n", (unsigned)version );
+		return 0;
+	}
+	return (int)pluginEntry( kNT_selector_numFactories, 0 );
+}
+
+const _NT_factory* NT_hostFactory( int index )
+{
+	return reinterpret_cast<const _NT_factory*>( pluginEntry( kNT_selector_factoryInfo, index ) );
+}
+
+static void initialiseFactory( const _NT_factory* factory )
+{
+	for ( int i = 0; i < numInitialisedFactories; ++i )
+		if ( initialisedFactories[i] == factory )
+			return;
+	if ( numInitialisedFactories < (int)ARRAY_SIZE(initialisedFactories) )
+		initialisedFactories[ numInitialisedFactories++ ] = factory;
+
+	if ( !factory->calculateStaticRequirements )
+		return;
+	_NT_staticRequirements req = { 0 };
+	factory->calculateStaticRequirements( req );
+	_NT_staticMemoryPtrs ptrs = { static_cast<uint8_t*>( allocZeroed( req.dram ) ) };
+	if ( factory->initialise )
+		factory->initialise( ptrs, req );
+}
+
+bool NT_hostConstruct( NT_hostInstance& inst, const _NT_factory* factory, const int32_t* specifications )
+{
+	std::memset( &inst, 0, sizeof(inst) );
+	inst.factory = factory;
+
+	if ( factory->numSpecifications > (uint32_t)kNT_hostMaxSpecifications )
+	{
+		std::fprintf( stderr, "nt_host: %s has too many specifications\n", factory->name );
+		return false;
+	}
+	for ( uint32_t i = 0; i < factory->numSpecifications; ++i )
+		inst.specifications[i] = specifications ? specifications[i] : factory->specifications[i].def;
+
+	initialiseFactory( factory );
+
+	factory->calculateRequirements( inst.req, inst.specifications );
+	inst.ptrs.sram = static_cast<uint8_t*>( allocZeroed( inst.req.sram ) );
+	inst.ptrs.dram = static_cast<uint8_t*>( allocZeroed( inst.req.dram ) );
+	inst.ptrs.dtc  = static_cast<uint8_t*>( allocZeroed( inst.req.dtc ) );
+	inst.ptrs.itc  = static_cast<uint8_t*>( allocZeroed( inst.req.itc ) );
+
+	inst.algorithm = factory->construct( inst.ptrs, inst.req, inst.specifications );
+	if ( !inst.algorithm )
+	{
+		std::fprintf( stderr, "nt_host: %s construct() failed\n", factory->name );
+		return false;
+	}
+
+	int numValues = kNT_hostCommonParameters + inst.req.numParameters;
+	inst.values = static_cast<int16_t*>( allocZeroed( numValues * sizeof(int16_t) ) );
+	for ( uint32_t p = 0; p < inst.req.numParameters; ++p )
+		inst.values[ kNT_hostCommonParameters + p ] = inst.algorithm->parameters[p].def;
+	inst.algorithm->vIncludingCommon = inst.values;
+	inst.algorithm->v = inst.values + kNT_hostCommonParameters;
+
+	for ( int i = 0; i < kNT_hostMaxInstances; ++i )
+	{
+		if ( !instances[i] )
+		{
+			instances[i] = &inst;
+			break;
+		}
+	}
+
+	for ( uint32_t p = 0; p < inst.req.numParameters; ++p )
+		factory->parameterChanged( inst.algorithm, p );
+	return true;
+}
+
+void NT_hostDestroy( NT_hostInstance& inst )
+{
+	for ( int i = 0; i < kNT_hostMaxInstances; ++i )
+		if ( instances[i] == &inst )
+			instances[i] = nullptr;
+	std::free( inst.ptrs.sram );
+	std::free( inst.ptrs.dram );
+	std::free( inst.ptrs.dtc );
+	std::free( inst.ptrs.itc );
+	std::free( inst.values );
+	std::memset( &inst, 0, sizeof(inst) );
+}
+
+void NT_hostSetParameter( NT_hostInstance& inst, int parameter, int16_t value )
+{
+	const _NT_parameter& def = inst.algorithm->parameters[parameter];
+	if ( value < def.min ) value = def.min;
+	if ( value > def.max ) value = def.max;
+	inst.values[ kNT_hostCommonParameters + parameter ] = value;
+	inst.factory->parameterChanged( inst.algorithm, parameter );
+}
+
+void NT_hostStep( NT_hostInstance& inst, float* busFrames, int numFrames )
+{
+	inst.factory->step( inst.algorithm, busFrames, numFrames / 4 );
+}
+
+bool NT_hostMidiRealtime( NT_hostInstance& inst, uint8_t byte )
+{
+	if ( !inst.factory->midiRealtime )
+		return false;
+	inst.factory->midiRealtime( inst.algorithm, byte );
+	return true;
+}
+
+bool NT_hostDraw( NT_hostInstance& inst )
+{
+	if ( !inst.factory->draw )
+		return false;
+	std::memset( NT_screen, 0, sizeof(NT_screen) );
+	drawnTextLength = 0;
+	drawnText[0] = 0;
+	inst.factory->draw( inst.algorithm );
+	return true;
+}
+
+const char* NT_hostDrawnText()
+{
+	return drawnText;
+}
+
+//—-----------------------------------------------------------------------------------------------
+// api.h symbols
+//—-----------------------------------------------------------------------------------------------
+
+uint8_t NT_screen[128*64];
+
+void NT_setParameterRange( _NT_parameter* ptr, float init, float min, float max, float step )
+{
+	int scaling = kNT_scalingNone;
+	float mul = 1.0f;
+	while ( scaling < kNT_scaling1000 && step * mul < 1.0f )
+	{
+		++scaling;
+		mul *= 10.0f;
+	}
+	ptr->scaling = scaling;
+	ptr->min = (int16_t)( min * mul );
+	ptr->max = (int16_t)( max * mul );
+	ptr->def = (int16_t)( init * mul );
+}
+
+uint32_t NT_getCpuCycleCount(void)
+{
+	if ( simulatedCycles )
+		return (uint32_t)( simulatedCycleFrame * kNT_hostCyclesPerFrame );
+#if defined(__x86_64__) || defined(__i386__)
+	return (uint32_t)__rdtsc();
+#else
+	using namespace std::chrono;
+	return (uint32_t)duration_cast<nanoseconds>( steady_clock::now().time_since_epoch() ).count();
+#endif
+}
+
+int32_t NT_algorithmIndex( const _NT_algorithm* algorithm )
+{
+	for ( int i = 0; i < kNT_hostMaxInstances; ++i )
+		if ( instances[i] && instances[i]->algorithm == algorithm )
+			return i;
+	return -1;
+}
+
+void NT_setParameterFromAudio( uint32_t algorithmIndex, uint32_t parameter, int16_t value )
+{
+	if ( algorithmIndex >= (uint32_t)kNT_hostMaxInstances || !instances[algorithmIndex] )
+		return;
+	NT_hostInstance& inst = *instances[algorithmIndex];
+	if ( parameter < (uint32_t)kNT_hostCommonParameters )
+		return;
+	parameter -= kNT_hostCommonParameters;
+	if ( parameter >= inst.req.numParameters )
+		return;
+	NT_hostSetParameter( inst, parameter, value );
+}
+
+void NT_setParameterFromUi( uint32_t algorithmIndex, uint32_t parameter, int16_t value )
+{
+	NT_setParameterFromAudio( algorithmIndex, parameter, value );
+}
+
+uint32_t NT_parameterOffset(void)
+{
+	return kNT_hostCommonParameters;
+}
+
+void NT_drawText( int /*x*/, int /*y*/, const char* str, int /*colour*/, _NT_textAlignment /*align*/, _NT_textSize /*size*/ )
+{
+	size_t len = std::strlen( str );
+	if ( drawnTextLength + len + 2 > sizeof(drawnText) )
+		return;
+	std::memcpy( drawnText + drawnTextLength, str, len );
+	drawnTextLength += len;
+	drawnText[ drawnTextLength++ ] = '\n';
+	drawnText[ drawnTextLength ] = 0;
+}
+
+void NT_drawShapeI( _NT_shape /*shape*/, int /*x0*/, int /*y0*/, int /*x1*/, int /*y1*/, int /*colour*/ )
+{
+}
+
+void NT_drawShapeF( _NT_shape /*shape*/, float /*x0*/, float /*y0*/, float /*x1*/, float /*y1*/, float /*colour*/ )
+{
+}
+
+int NT_intToString( char* buffer, int32_t value )
+{
+	return std::sprintf( buffer, "%d", (int)value );
+}
+
+int NT_floatToString( char* buffer, float value, int decimalPlaces )
+{
+	return std::sprintf( buffer, "%.*f", decimalPlaces, value );
+}
+
+static void sendMidi( uint32_t destination, const uint8_t* bytes, int length )
+{
+	++midiCount;
+	if ( midiHook )
+		midiHook( midiHookUser, destination, bytes, length );
+}
+
+void NT_sendMidiByte( uint32_t destination, uint8_t b0 )
+{
+	uint8_t bytes[1] = { b0 };
+	sendMidi( destination, bytes, 1 );
+}
+
+void NT_sendMidi2ByteMessage( uint32_t destination, uint8_t b0, uint8_t b1 )
+{
+	uint8_t bytes[2] = { b0, b1 };
+	sendMidi( destination, bytes, 2 );
+}
+
+void NT_sendMidi3ByteMessage( uint32_t destination, uint8_t b0, uint8_t b1, uint8_t b2 )
+{
+	uint8_t bytes[3] = { b0, b1, b2 };
+	sendMidi( destination, bytes, 3 );
+}
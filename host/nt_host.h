@@ -0,0 +1,87 @@
+// nt_host.h
+//
+// Host-side stand-in for the disting NT runtime.
+// • Provides every symbol declared in api/distingnt/api.h so a plug-in can be
+//   linked into a desktop executable.
+// • Drives a factory the way the module does: static requirements, initialise,
+//   requirements, construct, parameterChanged() for every parameter, then step().
+// • Plug-ins see NT_globals as const; the host configures it through
+//   NT_hostConfigure() before any factory is touched.
+
+#ifndef _NT_HOST_H
+#define _NT_HOST_H
+
+#include "distingnt/api.h"
+
+// Number of common parameters (e.g. bypass) that precede a plug-in's own
+// parameters in vIncludingCommon. Returned by NT_parameterOffset().
+static const int kNT_hostCommonParameters = 1;
+
+// Maximum number of live instances tracked for NT_algorithmIndex().
+static const int kNT_hostMaxInstances = 32;
+
+// Maximum number of specifications a factory may declare.
+static const int kNT_hostMaxSpecifications = 8;
+
+// Number of busses passed to step().
+static const int kNT_hostNumBusses = 28;
+
+// Sets sample rate and block size, and (re)allocates the work buffer.
+void NT_hostConfigure( uint32_t sampleRate, uint32_t maxFramesPerStep );
+
+// Called for every MIDI message a plug-in sends. length is 1, 2 or 3.
+typedef void (*NT_hostMidiHook)( void* user, uint32_t destination, const uint8_t* bytes, int length );
+void NT_hostSetMidiHook( NT_hostMidiHook hook, void* user );
+
+// Total MIDI messages sent since start-up.
+uint32_t NT_hostMidiCount();
+
+// Simulated CPU clock for timing tests. After NT_hostSetCycleFrame(),
+// NT_getCpuCycleCount() returns frame * kNT_hostCyclesPerFrame, wrapping at
+// 2^32 like the module's counter, so a simulator can say at which audio frame
+// a step() or midiRealtime() call happens. NT_hostRealCycleClock() goes back
+// to the real counter.
+static const uint32_t kNT_hostCyclesPerFrame = 10000;	// 480 MHz at 48 kHz
+void NT_hostSetCycleFrame( uint64_t frame );
+void NT_hostRealCycleClock();
+
+// Number of factories exported by the linked plug-in (0 if the API version is unsupported).
+int NT_hostNumFactories();
+const _NT_factory* NT_hostFactory( int index );
+
+// One constructed plug-in instance plus the memory the host allocated for it.
+struct NT_hostInstance
+{
+	const _NT_factory*			factory;
+	_NT_algorithm*				algorithm;
+	_NT_algorithmRequirements	req;
+	_NT_algorithmMemoryPtrs		ptrs;
+	int32_t						specifications[kNT_hostMaxSpecifications];
+	int16_t*					values;			// vIncludingCommon
+};
+
+// Runs calculateStaticRequirements()/initialise() once per factory, then
+// calculateRequirements()/construct(), populates default parameter values,
+// and calls parameterChanged() for every parameter.
+// specifications may be NULL to use the factory defaults.
+bool NT_hostConstruct( NT_hostInstance& inst, const _NT_factory* factory, const int32_t* specifications );
+void NT_hostDestroy( NT_hostInstance& inst );
+
+// Sets a plug-in parameter (own index, not including common) and notifies the instance.
+void NT_hostSetParameter( NT_hostInstance& inst, int parameter, int16_t value );
+
+// Calls step() for numFrames (must be a multiple of 4) on a 28-bus buffer.
+void NT_hostStep( NT_hostInstance& inst, float* busFrames, int numFrames );
+
+// Delivers one realtime MIDI byte (clock, start, stop...) through midiRealtime(),
+// if the factory provides one. Returns false if it does not.
+bool NT_hostMidiRealtime( NT_hostInstance& inst, uint8_t byte );
+
+// Clears the screen and calls draw() if the factory provides one.
+// Returns false if there is no draw().
+bool NT_hostDraw( NT_hostInstance& inst );
+
+// Every string passed to NT_drawText() during the last NT_hostDraw(), one per line.
+const char* NT_hostDrawnText();
+
+#endif // _NT_HOST_H
@@ -0,0 +1,184 @@
+// pathopt.cpp
+//
+// Offline drawing-path optimiser for the mesh library in noculling.cpp.
+// Every shape is drawn as one closed path, so each odd-degree vertex needs a
+// blanked reposition move. initialise() pairs odd vertices greedily; this tool
+// pairs them with an exact minimum-length perfect matching (a bitmask DP, which
+// is quick for the 20 or fewer odd vertices these meshes have) and then walks
+// the result with the same Hierholzer routine. Since reposition moves are
+// straight lines, that gives the least total blanked travel any closed path
+// over the edges can have.
+//
+// Usage: pathopt              report greedy vs optimised paths per shape
+//        pathopt -o <file.h>  also write the table noculling.cpp includes
+//
+// Exits with 1 if the checked-in mesh_paths.h differs from what it would
+// generate, so "make bench" catches a stale table after a shape changes.
+
+#include "nt_host.h"
+#include "plugins/sequencer_v1/noculling.cpp"
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+// Exact minimum-weight perfect matching over the odd vertices. dp[mask] is the
+// cheapest way to pair up the vertices in mask; each step pairs the lowest
+// unpaired vertex, so every matching is reached exactly once.
+static int pairOddExact(const float (*verts)[3], int numVerts,
+                        uint8_t* degree, Segment* edges, int ne) {
+    int odd[32];
+    int k = 0;
+    for (int v = 0; v < numVerts; ++v)
+        if (degree[v] & 1) odd[k++] = v;
+    if (k == 0) return ne;
+
+    const uint32_t full = (1u << k) - 1;
+    std::vector<float> dp(full + 1, 1e30f);
+    std::vector<uint16_t> pick(full + 1, 0);
+    dp[0] = 0.0f;
+    for (uint32_t mask = 0; mask < full; ++mask) {
+        if (dp[mask] >= 1e30f) continue;
+        int i = 0;
+        while (mask & (1u << i)) ++i;
+        for (int j = i + 1; j < k; ++j) {
+            if (mask & (1u << j)) continue;
+            uint32_t next = mask | (1u << i) | (1u << j);
+            float cost = dp[mask] + vertDist(verts, odd[i], odd[j]);
+            if (cost < dp[next]) {
+                dp[next] = cost;
+                pick[next] = static_cast<uint16_t>((i << 8) | j);
+            }
+        }
+    }
+    for (uint32_t mask = full; mask; ) {
+        int i = pick[mask] >> 8, j = pick[mask] & 0xFF;
+        edges[ne++] = { static_cast<uint8_t>(odd[i]), static_cast<uint8_t>(odd[j]), 0 };
+        degree[odd[i]]++;
+        degree[odd[j]]++;
+        mask &= ~((1u << i) | (1u << j));
+    }
+    return ne;
+}
+
+static int buildOptimalPath(const float (*verts)[3], int numVerts,
+                            const Segment* edgeList, int numEdges,
+                            PathScratch& s, Segment* out) {
+    memset(s.degree, 0, numVerts);
+    for (int e = 0; e < numEdges; ++e) {
+        s.edges[e] = edgeList[e];
+        s.degree[edgeList[e].a]++;
+        s.degree[edgeList[e].b]++;
+    }
+    int ne = pairOddExact(verts, numVerts, s.degree, s.edges, numEdges);
+    return walkEulerCircuit(ne, s, out);
+}
+
+// Field by field: Segment has a padding byte, so memcmp() would compare junk.
+static bool sameSegments(const Segment* x, const Segment* y, int n) {
+    for (int i = 0; i < n; ++i)
+        if (x[i].a != y[i].a || x[i].b != y[i].b || x[i].draw != y[i].draw) return false;
+    return true;
+}
+
+struct PathStats { int drawn, moves; float visibleLen, blankLen; };
+
+static PathStats pathStats(const float (*verts)[3], const Segment* segs, int n) {
+    PathStats p = { 0, 0, 0.0f, 0.0f };
+    for (int i = 0; i < n; ++i) {
+        float len = vertDist(verts, segs[i].a, segs[i].b);
+        if (segs[i].draw) { p.drawn++; p.visibleLen += len; }
+        else              { p.moves++; p.blankLen   += len; }
+    }
+    return p;
+}
+
+static float ratio(float a, float b) { return (b > 0.0f) ? a / b : 0.0f; }
+
+int main(int argc, char** argv) {
+    const char* outPath = nullptr;
+    if (argc == 3 && !strcmp(argv[1], "-o"))
+        outPath = argv[2];
+    else if (argc != 1) {
+        std::fprintf(stderr, "usage: %s [-o mesh_paths.h]\n", argv[0]);
+        return 2;
+    }
+
+    NT_hostConfigure(48000, 128);
+    _NT_staticRequirements req;
+    calculateStaticRequirements(req);
+    std::vector<uint8_t> dram(req.dram);
+    _NT_staticMemoryPtrs ptrs = { dram.data() };
+    initialise(ptrs, req);
+
+    int maxSegs = 0, maxVerts = 0;
+    for (int s = 0; s < kNumShapes; ++s) {
+        if (shapeMaxSegments(s) > maxSegs) maxSegs = shapeMaxSegments(s);
+        if (shapeSpecs[s].numVerts > maxVerts) maxVerts = shapeSpecs[s].numVerts;
+    }
+    std::vector<uint8_t> scratchMem(pathScratchBytes(maxSegs, maxVerts));
+    PathScratch scratch = carvePathScratch(scratchMem.data(), maxSegs);
+
+    std::vector<Segment> edges(maxSegs), greedy(maxSegs);
+    std::vector<std::vector<Segment>> optimal(kNumShapes);
+    std::vector<int> numEdges(kNumShapes);
+    bool stale = false;
+
+    // Length ratios equal time ratios at a constant beam speed (Arc length
+    // traversal with BlankTime matched to the path); "uniform on" is the share
+    // of the period the beam is lit under Uniform traversal.
+    std::printf("%-13s %5s %5s %8s | %8s %9s %10s | %8s %9s %10s\n",
+                "shape", "edges", "moves", "visible",
+                "greedy", "vis:blank", "uniform on",
+                "optimal", "vis:blank", "uniform on");
+    for (int s = 0; s < kNumShapes; ++s) {
+        const Mesh& m = sharedMeshes[s];
+        int ne = buildShapeEdges(s, m.verts, m.numVerts, edges.data());
+        numEdges[s] = ne;
+
+        int ng = buildEulerPath(m.verts, m.numVerts, edges.data(), ne, scratch, greedy.data());
+        optimal[s].resize(maxSegs);
+        int no = buildOptimalPath(m.verts, m.numVerts, edges.data(), ne, scratch, optimal[s].data());
+        optimal[s].resize(no);
+
+        PathStats g = pathStats(m.verts, greedy.data(), ng);
+        PathStats o = pathStats(m.verts, optimal[s].data(), no);
+        std::printf("%-13s %5d %5d %8.3f | %8.3f %9.2f %9.1f%% | %8.3f %9.2f %9.1f%%\n",
+                    shapeSpecs[s].name, ne, o.moves, o.visibleLen,
+                    g.blankLen, ratio(g.visibleLen, g.blankLen), 100.0f * g.drawn / ng,
+                    o.blankLen, ratio(o.visibleLen, o.blankLen), 100.0f * o.drawn / no);
+
+        const MeshPath& cur = meshPaths[s];
+        if (cur.numVerts != m.numVerts || cur.numEdges != ne || cur.numSegs != no ||
+            !sameSegments(cur.segs, optimal[s].data(), no))
+            stale = true;
+    }
+
+    if (outPath) {
+        FILE* f = std::fopen(outPath, "w");
+        if (!f) { std::perror(outPath); return 1; }
+        std::fprintf(f, "// mesh_paths.h\n//\n// Generated by host/pathopt (\"make paths\"). Do not edit.\n");
+        std::fprintf(f, "// Closed drawing paths with the least total blanked travel for each shape.\n");
+        for (int s = 0; s < kNumShapes; ++s) {
+            std::fprintf(f, "\nstatic const Segment meshPath%s[] = {", shapeSpecs[s].name);
+            for (size_t i = 0; i < optimal[s].size(); ++i) {
+                const Segment& g = optimal[s][i];
+                std::fprintf(f, "%s{%d,%d,%d},", (i % 8) ? " " : "\n    ", g.a, g.b, g.draw);
+            }
+            std::fprintf(f, "\n};\n");
+        }
+        std::fprintf(f, "\nstatic const MeshPath meshPaths[kNumShapes] = {\n");
+        for (int s = 0; s < kNumShapes; ++s)
+            std::fprintf(f, "    { meshPath%s, %d, %d, %d },\n", shapeSpecs[s].name,
+                         sharedMeshes[s].numVerts, numEdges[s], static_cast<int>(optimal[s].size()));
+        std::fprintf(f, "};\n");
+        std::fclose(f);
+        std::printf("wrote %s\n", outPath);
+        return 0;
+    }
+    if (stale) {
+        std::printf("mesh_paths.h is out of date: run \"make paths\"\n");
+        return 1;
+    }
+    return 0;
+}
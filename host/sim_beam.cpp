@@ -0,0 +1,229 @@
+// sim_beam.cpp
+//
+// Corner dwell check for the cube renderer. For every shape, culling mode
+// and a one- and three-object scene, renders one period at Dwell kDwell in
+// each traversal and finds the holds: runs of samples where X and Y do not
+// move. Fails unless both traversals hold once per lit edge, in path order,
+// each hold lit exactly when dwellLit() says so (dark after a blanked move
+// or hidden edge), so Uniform and Arc length blank their dwells the same.
+// Then spins two objects at one position in Arc length and fails unless
+// every hop between them keeps a blanked entry in the timing table, timed
+// within kHopRetime of the distance between the vertices it joins. Last,
+// turns Slew off and on again and fails unless the beam slews on from where
+// it was, not from where it stood when Slew was last on.
+//
+// Usage: sim_beam
+//
+// Includes noculling.cpp directly so the scene path and dwellLit() are visible.
+
+#include "nt_host.h"
+#include "plugins/sequencer_v1/noculling.cpp"
+
+#include <cstdio>
+#include <vector>
+
+// Parameter indices, as in parameterChanged().
+static const int kParamFreq = 0, kParamTraversal = 18, kParamCulling = 20, kParamSpinX = 26,
+                 kParamDwell = 29, kParamSlew = 30;
+
+static const int kDwell = 6;
+static const int kFreq = 5;             // long enough periods for every dwell
+static const int kFramesPerStep = 64;
+static const int kMinHold = 3;          // a hold may lose a sample to the phase
+
+struct Hold { int length; bool lit; bool steady; };
+
+// One period from phase 0 at the given settings; returns the holds in order
+// and the lit/dark pattern dwellLit() expects from the scene path.
+static bool renderHolds(int shape, int numObjects, int culling, int traversal,
+                        std::vector<Hold>& holds, std::vector<bool>& expected) {
+    int32_t specs[2] = { shape, numObjects };
+    NT_hostInstance inst;
+    if (!NT_hostConstruct(inst, NT_hostFactory(0), specs)) return false;
+    NT_hostSetParameter(inst, 1, 30);
+    NT_hostSetParameter(inst, 2, 45);
+    NT_hostSetParameter(inst, 3, 10);
+    NT_hostSetParameter(inst, kParamFreq, kFreq);
+    NT_hostSetParameter(inst, kParamTraversal, traversal);
+    NT_hostSetParameter(inst, kParamCulling, culling);
+    NT_hostSetParameter(inst, kParamDwell, kDwell);
+    for (int n = 0; n < numObjects; ++n) {
+        int base = kNumBaseParams + n * kObjectParams;
+        NT_hostSetParameter(inst, base + kObjScale, 50);
+        NT_hostSetParameter(inst, base + kObjPosX, -60 + 60 * n);
+        NT_hostSetParameter(inst, base + kObjPosY, 20 * n);
+    }
+
+    const int numSteps = NT_globals.sampleRate / kFreq / kFramesPerStep;
+    std::vector<float> bus(kNT_hostNumBusses * kFramesPerStep);
+    // The last sample of a run may be the next edge's first, still on the
+    // vertex and in its blank window, so a hold's blanking is judged on the
+    // samples before it.
+    float lastX = 0.0f, lastY = 0.0f;
+    bool lastLit = false;
+    int run = 0;
+    bool runLit = false, steady = true, heldSteady = true;
+    holds.clear();
+    for (int s = 0; s < numSteps; ++s) {
+        NT_hostStep(inst, bus.data(), kFramesPerStep);
+        const float* X = &bus[12 * kFramesPerStep];
+        const float* Y = &bus[13 * kFramesPerStep];
+        const float* I = &bus[14 * kFramesPerStep];
+        for (int i = 0; i < kFramesPerStep; ++i) {
+            bool lit = I[i] > 0.0f;
+            if (s + i > 0 && X[i] == lastX && Y[i] == lastY) {
+                if (run == 0) { run = 1; runLit = lastLit; steady = true; }
+                heldSteady = steady;
+                steady &= lit == runLit;
+                ++run;
+            } else {
+                if (run >= kMinHold) holds.push_back({ run, runLit, heldSteady });
+                run = 0;
+            }
+            lastX = X[i];
+            lastY = Y[i];
+            lastLit = lit;
+        }
+    }
+    if (run >= kMinHold) holds.push_back({ run, runLit, heldSteady });
+
+    PolyInstance* self = static_cast<PolyInstance*>(inst.algorithm);
+    expected.clear();
+    for (int i = 0; i < self->numSceneSegs; ++i) {
+        if (self->sceneSegs[i].draw == kSegLit) expected.push_back(dwellLit(self->sceneSegs, i, self->numSceneSegs));
+    }
+    NT_hostDestroy(inst);
+    return true;
+}
+
+// Two objects at the default position, spinning, for a second. Returns the
+// number of blocks whose hops were untimed or timed from stale vertices.
+static int checkHops(int shape, int culling) {
+    int32_t specs[2] = { shape, 2 };
+    NT_hostInstance inst;
+    if (!NT_hostConstruct(inst, NT_hostFactory(0), specs)) return 1;
+    NT_hostSetParameter(inst, kParamTraversal, 1);
+    NT_hostSetParameter(inst, kParamCulling, culling);
+    NT_hostSetParameter(inst, kParamSpinX, 900);
+    NT_hostSetParameter(inst, kParamSpinX + 1, -450);
+    NT_hostSetParameter(inst, kNumBaseParams + kObjRotY, 90);
+    NT_hostSetParameter(inst, kNumBaseParams + kObjectParams + kObjScale, 50);
+
+    PolyInstance* self = static_cast<PolyInstance*>(inst.algorithm);
+    std::vector<float> bus(kNT_hostNumBusses * kFramesPerStep);
+    const int numSteps = NT_globals.sampleRate / kFramesPerStep;
+    int bad = 0;
+    for (int s = 0; s < numSteps; ++s) {
+        NT_hostStep(inst, bus.data(), kFramesPerStep);
+        for (int k = 0; k < 2; ++k) {
+            const int hop = self->sceneHop[k];
+            const Segment& sg = self->sceneSegs[hop];
+            float d = 0.0f;
+            for (int a = 0; a < 3; ++a) {
+                float e = self->xverts[sg.b][a] - self->xverts[sg.a][a];
+                d += e * e;
+            }
+            d = sqrtf(d);
+            if (d < kMinHopLen) d = kMinHopLen;
+            bool timed = false;
+            for (int t = 0; t < self->numTimed; ++t) timed |= self->segTime[t].seg == hop;
+            if (sg.draw != kSegMove || !timed || fabsf(self->sceneLen[hop] - d) > kHopRetime) {
+                ++bad;
+                break;
+            }
+        }
+    }
+    NT_hostDestroy(inst);
+    return bad;
+}
+
+// Renders with Slew on, off while the mesh turns, then on again. Returns the
+// first sample's X/Y step after Slew comes back, in slew steps.
+static float slewReturnJump() {
+    int32_t specs[2] = { 0, 1 };
+    NT_hostInstance inst;
+    if (!NT_hostConstruct(inst, NT_hostFactory(0), specs)) return 1e30f;
+    std::vector<float> bus(kNT_hostNumBusses * kFramesPerStep);
+    const float* X = &bus[12 * kFramesPerStep];
+    const float* Y = &bus[13 * kFramesPerStep];
+    NT_hostSetParameter(inst, kParamTraversal, 1);
+    NT_hostSetParameter(inst, kParamSlew, 100);
+    for (int s = 0; s < 100; ++s) NT_hostStep(inst, bus.data(), kFramesPerStep);
+    NT_hostSetParameter(inst, kParamSlew, 0);
+    NT_hostSetParameter(inst, 2, 120);
+    for (int s = 0; s < 137; ++s) NT_hostStep(inst, bus.data(), kFramesPerStep);
+    float lastX = X[kFramesPerStep - 1], lastY = Y[kFramesPerStep - 1];
+    NT_hostSetParameter(inst, kParamSlew, 100);
+    NT_hostStep(inst, bus.data(), kFramesPerStep);
+    const float step = static_cast<PolyInstance*>(inst.algorithm)->slewStep;
+    float jump = fmaxf(fabsf(X[0] - lastX), fabsf(Y[0] - lastY)) / step;
+    NT_hostDestroy(inst);
+    return jump;
+}
+
+int main() {
+    NT_hostConfigure(48000, kFramesPerStep);
+    static const char* const cullNames[] = { "Off", "Blank", "Skip" };
+    static const char* const travNames[] = { "Uniform", "Arc length" };
+
+    int failures = 0, checked = 0, darkHolds = 0;
+    for (int shape = 0; shape < kNumShapes; ++shape) {
+        for (int numObjects = 1; numObjects <= 3; numObjects += 2) {
+            for (int culling = 0; culling < 3; ++culling) {
+                std::vector<bool> lit[2];
+                for (int traversal = 0; traversal < 2; ++traversal) {
+                    std::vector<Hold> holds;
+                    std::vector<bool> expected;
+                    const char* failure = nullptr;
+                    if (!renderHolds(shape, numObjects, culling, traversal, holds, expected)) {
+                        failure = "construct failed";
+                    } else if (holds.size() != expected.size()) {
+                        failure = "not one hold per lit edge";
+                    } else {
+                        for (size_t k = 0; k < holds.size() && !failure; ++k) {
+                            if (!holds[k].steady) failure = "blanking changes during a hold";
+                            else if (holds[k].length > kDwell + 1) failure = "hold longer than Dwell";
+                            else if (holds[k].lit != expected[k]) failure = "hold blanked against dwellLit()";
+                            lit[traversal].push_back(holds[k].lit);
+                            darkHolds += !holds[k].lit;
+                        }
+                    }
+                    if (failure) {
+                        std::printf("%s, %d object(s), Culling %s, %s: FAIL %s (%zu holds, %zu lit edges)\n",
+                                    shapeSpecs[shape].name, numObjects, cullNames[culling], travNames[traversal],
+                                    failure, holds.size(), expected.size());
+                        ++failures;
+                    }
+                    checked += (int)holds.size();
+                }
+                if (lit[0] != lit[1]) {
+                    std::printf("%s, %d object(s), Culling %s: FAIL traversals blank dwells differently\n",
+                                shapeSpecs[shape].name, numObjects, cullNames[culling]);
+                    ++failures;
+                }
+            }
+        }
+    }
+    std::printf("Dwell %d: %d holds checked, %d dark\n", kDwell, checked, darkHolds);
+
+    for (int shape = 0; shape < kNumShapes; ++shape) {
+        for (int culling = 0; culling < 3; ++culling) {
+            int bad = checkHops(shape, culling);
+            if (bad) {
+                std::printf("%s, 2 objects, Culling %s: FAIL hops mistimed in %d blocks\n",
+                            shapeSpecs[shape].name, cullNames[culling], bad);
+                ++failures;
+            }
+        }
+    }
+    std::printf("Hops: %d shapes timed from their vertices\n", kNumShapes);
+
+    float jump = slewReturnJump();
+    std::printf("Slew back on: first step %.2f of the limit\n", jump);
+    if (jump > 1.001f) {
+        std::printf("FAIL slew resumed from a stale beam position\n");
+        ++failures;
+    }
+    if (failures) std::printf("%d failures\n", failures);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,675 @@
+// sim_seqtick.cpp
+//
+// Deterministic tick simulator for the MIDI Pattern Generator, run before
+// every firmware update:
+// • sweeps BPM 1..400, free-running, and times every tick from the Clock
+//   Output bus; fails if the mean period is off by more than kMaxTempoPpm or
+//   any tick strays more than one frame from the fitted tick grid;
+// • pairs every message sent with the frame time step() queued it at, and
+//   fails if times go backwards, a note-on is not on a tick, a note-off has
+//   no matching note-on or comes other than at its sequence's Gate (or a
+//   retrigger), or a note is still held after the clock stops;
+// • repeats the sweep at every seventh BPM with running status on the
+//   breakout, clocked by pulses on the Clock Input at 1 and 4 ticks per
+//   pulse, and following MIDI clock;
+// • repeats that at a few BPMs with 40 sequences, two or three to a channel, and
+//   fails if a note-off ends a note another sequence is still holding;
+// • runs an instance at BPM 0 and fails if it ticks or sends anything;
+// • switches MIDI Out between USB and the breakout while notes are held, and
+//   fails if a note is left sounding on the old port or the breakout's first
+//   byte after a switch is not a status byte;
+// • moves Clock Input, at 4 ticks per pulse, to a bus whose pulses fall a
+//   third of a pulse later, and fails if the first edge there is timed against the
+//   old bus (ticks bunch) or the follower does not settle again;
+// • follows MIDI clock at 120 BPM, turns MIDI Clock off for two seconds and
+//   back on, and fails if the follower plays a stale clock, bunches ticks or
+//   strays more than a frame from one tick per six clocks;
+// • reports the cost of one tick and the instance's memory at 1, 16 and 40
+//   sequences, all firing with Randomise on. 40 is the Sequences maximum, set by the uint8_t parameter
+//   indices of a page, so 64 and 256 cannot be built.
+//
+// Usage: sim_seqtick [-s secondsPerBpm] [-b framesPerStep]
+//
+// Includes plugin.cpp directly so the queued events and tick() are visible.
+
+#include "nt_host.h"
+#include "plugins/MyFirstPlugin/plugin.cpp"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+static const int kMinTicksPerBpm = 64;
+// A 32-bit phase increment is truncated, so at BPM 1 the period can be long
+// by up to 1/5965 (168 ppm).
+static const double kMaxTempoPpm = 200.0;
+
+struct Message { uint8_t bytes[3]; };
+
+// USB messages arrive whole. The breakout sends single bytes with running
+// status, decoded here as a receiver would; running is cleared before each
+// step(), since the plug-in restarts running status with every flush.
+struct Capture {
+    std::vector<Message> block;   // messages sent during the current step()
+    uint8_t running;
+    int numData;
+    uint8_t data[2];
+    uint64_t breakoutMessages, breakoutBytes;
+    int malformed;                // other lengths, or data with no status
+};
+
+static void captureMidi(void* user, uint32_t destination, const uint8_t* bytes, int length) {
+    Capture* c = static_cast<Capture*>(user);
+    Message m;
+    if (length == 3 && destination == kNT_destinationUSB) {
+        std::memcpy(m.bytes, bytes, 3);
+        c->block.push_back(m);
+        return;
+    }
+    if (length != 1 || destination != kNT_destinationBreakout) {
+        ++c->malformed;
+        return;
+    }
+    uint8_t b = bytes[0];
+    ++c->breakoutBytes;
+    if (b & 0x80) {
+        c->running = b;
+        c->numData = 0;
+        return;
+    }
+    if (!c->running) {
+        ++c->malformed;
+        return;
+    }
+    c->data[c->numData++] = b;
+    if (c->numData == 2) {
+        m.bytes[0] = c->running;
+        m.bytes[1] = c->data[0];
+        m.bytes[2] = c->data[1];
+        c->block.push_back(m);
+        c->numData = 0;
+        ++c->breakoutMessages;
+    }
+}
+
+enum ClockSource { CLOCK_FREE, CLOCK_INPUT, CLOCK_MIDI };
+
+struct SimMode {
+    const char* name;
+    int midiOut;          // MIDI Out: 0 USB, 1 breakout
+    ClockSource clock;
+    int ticksPerPulse;    // Clock Input only
+    int bpmStride;
+    int settleTicks;      // left out of the fit while a follower locks
+    double maxJitterFrames, maxJitterBlocks;
+};
+
+// Clock Input pulses are 1 ms wide on this bus (Clock Input parameter 2).
+static const int kClockInBus = 1;
+static const int kPulseFrames = 48;
+
+struct BpmResult {
+    uint64_t ticks, events;
+    double tempoPpm;      // mean period against the ideal
+    double jitterFrames;  // worst distance from the fitted grid
+    const char* failure;
+};
+
+// Varied settings so the sweep covers every direction and divider, and gates
+// of different lengths queue note-offs out of firing order.
+static void setUpSequences(NT_hostInstance& inst, int numSeqs) {
+    for (int s = 0; s < numSeqs; ++s) {
+        int base = IDX_SEQ_BASE + s * SEQ_NUM_PARAMS;
+        NT_hostSetParameter(inst, base + SEQ_INCLUDE, s % 4 != 1);
+        NT_hostSetParameter(inst, base + SEQ_STEPS, 3 + s % 14);
+        NT_hostSetParameter(inst, base + SEQ_DIV, 1 + s % 3);
+        NT_hostSetParameter(inst, base + SEQ_RANGE, 20 + s % 100);
+        NT_hostSetParameter(inst, base + SEQ_DIR, s % 3);
+        NT_hostSetParameter(inst, base + SEQ_GATE, 10 + s % 5 * 60);
+    }
+    NT_hostSetParameter(inst, IDX_RANDOMIZE, 1);
+}
+
+// The clock stops at the end of the run: BPM drops to 0, the pulses stop a
+// pulse early so interpolated ticks finish in time, or Stop is sent.
+static BpmResult simulateBpm(const SimMode& mode, int bpm, int numSeqs, double seconds, int framesPerStep,
+                             Capture& cap) {
+    BpmResult r = { 0, 0, 0.0, 0.0, nullptr };
+    int32_t specs[NUM_SPECS] = { numSeqs, specifications[SPEC_STEPS].def };
+    NT_hostInstance inst;
+    if (!NT_hostConstruct(inst, NT_hostFactory(0), specs)) {
+        r.failure = "construct failed";
+        return r;
+    }
+    Plugin* self = static_cast<Plugin*>(inst.algorithm);
+    setUpSequences(inst, self->lanes.numSeqs);
+    NT_hostSetParameter(inst, IDX_BPM, bpm);
+    NT_hostSetParameter(inst, IDX_MIDI_OUT, mode.midiOut);
+    if (mode.clock == CLOCK_INPUT) {
+        NT_hostSetParameter(inst, IDX_CLOCK_IN, kClockInBus + 1);
+        NT_hostSetParameter(inst, IDX_PULSE_TICKS, mode.ticksPerPulse);
+    } else if (mode.clock == CLOCK_MIDI) {
+        NT_hostSetParameter(inst, IDX_MIDI_CLOCK, 1);
+        NT_hostSetCycleFrame(0);
+        NT_hostMidiRealtime(inst, 0xFA);
+    }
+
+    const uint32_t sr = NT_globals.sampleRate;
+    const double period = sr * 60.0 / (bpm * 4.0);
+    const double pulsePeriod = period * mode.ticksPerPulse;
+    const double clockPeriod = period / MIDI_CLOCKS_PER_TICK;
+    uint64_t frames = (uint64_t)(seconds * sr);
+    uint64_t minFrames = (uint64_t)(period * (kMinTicksPerBpm + mode.settleTicks + 1) + pulsePeriod);
+    if (frames < minFrames) frames = minFrames;
+    uint64_t numSteps = frames / framesPerStep;
+    const uint64_t pulsesEnd = numSteps * framesPerStep - (uint64_t)pulsePeriod;
+    uint64_t nextClock = 0, clocks = 0;
+    const uint64_t releaseSteps = (uint64_t)sr * 3 / framesPerStep;   // longer than any gate
+
+    std::vector<float> bus(kNT_hostNumBusses * framesPerStep);
+    std::vector<uint64_t> tickFrames;
+    static int held[16][128];   // note-ons since the note last ended, as a synth sees it
+    std::memset(held, 0, sizeof(held));
+    // Up to 16 sequences each own a channel, so each note-off can be matched
+    // to its sequence's Gate.
+    const bool ownChannels = numSeqs <= 16;
+    uint64_t onTime[16] = {}, gateFrames[16] = {};
+    for (int ch = 0; ch < 16 && ch < numSeqs; ++ch)
+        gateFrames[ch] = (uint64_t)inst.algorithm->v[IDX_SEQ_BASE + ch * SEQ_NUM_PARAMS + SEQ_GATE] * sr / 1000;
+    uint64_t lastTime = 0;
+
+    for (uint64_t i = 0; i < numSteps + releaseSteps && !r.failure; ++i) {
+        uint64_t start = i * framesPerStep;
+        if (i == numSteps) {
+            NT_hostSetParameter(inst, IDX_BPM, 0);
+            if (mode.clock == CLOCK_MIDI) {
+                NT_hostSetCycleFrame(start - 1);
+                NT_hostMidiRealtime(inst, 0xFC);
+            }
+        }
+        std::memset(bus.data(), 0, framesPerStep * sizeof(float));
+        if (mode.clock == CLOCK_INPUT) {
+            float* in = bus.data() + kClockInBus * framesPerStep;
+            for (int f = 0; f < framesPerStep; ++f) {
+                uint64_t t = start + f;
+                in[f] = (t < pulsesEnd && std::fmod((double)t, pulsePeriod) < kPulseFrames) ? 5.0f : 0.0f;
+            }
+        } else if (mode.clock == CLOCK_MIDI && i < numSteps) {
+            // Bytes that arrived during the previous block, each at its frame.
+            for (; nextClock < start; nextClock = (uint64_t)std::ceil(++clocks * clockPeriod)) {
+                NT_hostSetCycleFrame(nextClock);
+                NT_hostMidiRealtime(inst, 0xF8);
+            }
+        }
+        if (mode.clock == CLOCK_MIDI) NT_hostSetCycleFrame(start);
+        cap.block.clear();
+        cap.running = 0;
+        cap.numData = 0;
+        NT_hostStep(inst, bus.data(), framesPerStep);
+
+        size_t firstTick = tickFrames.size();
+        for (int f = 0; f < framesPerStep; ++f) {
+            if (bus[f] != 0.0f) tickFrames.push_back(start + f);
+        }
+        if (i >= numSteps && tickFrames.size() != firstTick) r.failure = "ticked after the clock stopped";
+
+        // Each flush hands the queue to the port in order, so the k-th message
+        // of the block is events[k] unless the queue overflowed mid-block.
+        if (cap.block.size() > (size_t)self->midiOut.capacity) {
+            r.failure = "MIDI queue overflowed within one block";
+            break;
+        }
+        for (size_t k = 0; k < cap.block.size() && !r.failure; ++k) {
+            const MidiEvent& e = self->midiOut.events[k];
+            const uint8_t* b = cap.block[k].bytes;
+            uint8_t status = e.status, data2 = e.data2;
+            if (mode.midiOut == 1 && (status & 0xF0) == 0x80) {
+                status = 0x90 | (status & 15);   // velocity-0 note-on keeps the running status
+                data2 = 0;
+            }
+            if (b[0] != status || b[1] != e.data1 || b[2] != data2) {
+                r.failure = "sent message does not match the queue";
+                break;
+            }
+            uint64_t t = start + (int32_t)(e.time - (uint32_t)start);
+            if (t < start || t >= start + framesPerStep) r.failure = "event time outside its block";
+            else if (t < lastTime) r.failure = "event times go backwards";
+            lastTime = t;
+
+            int ch = b[0] & 15, note = b[1];
+            bool onTick = false;
+            for (size_t j = firstTick; j < tickFrames.size(); ++j) onTick |= tickFrames[j] == t;
+            if ((b[0] & 0xF0) == 0x90 && b[2] > 0) {
+                if (!onTick) r.failure = "note-on away from a tick";
+                ++held[ch][note];
+                onTime[ch] = t;
+                ++r.events;
+            } else if ((b[0] & 0xF0) == 0x80 || (b[0] & 0xF0) == 0x90) {
+                if (held[ch][note] == 0) r.failure = "note-off without a note-on";
+                else if (ownChannels && t != onTime[ch] + gateFrames[ch] &&
+                         !(onTick && t < onTime[ch] + gateFrames[ch]))
+                    r.failure = "note-off away from its Gate";
+                held[ch][note] = 0;
+                ++r.events;
+            } else {
+                r.failure = "unexpected message";
+            }
+        }
+        // Every note a sequence has yet to release must still be sounding.
+        for (int seq = 0; seq < numSeqs && !r.failure; ++seq) {
+            if (self->noteOffs.pending[seq] && !held[seq & 15][self->noteOffs.note[seq]])
+                r.failure = "note ended while another sequence holds it";
+        }
+    }
+    for (int ch = 0; ch < 16 && !r.failure; ++ch)
+        for (int note = 0; note < 128; ++note)
+            if (held[ch][note]) r.failure = "note held after the clock stopped";
+    NT_hostDestroy(inst);
+    NT_hostRealCycleClock();
+
+    r.ticks = tickFrames.size();
+    if (!r.failure && r.ticks < (uint64_t)mode.settleTicks + 2) r.failure = "too few ticks";
+    if (r.failure) return r;
+
+    // Least-squares grid through the tick times; tempo from its slope.
+    tickFrames.erase(tickFrames.begin(), tickFrames.begin() + mode.settleTicks);
+    double n = (double)tickFrames.size(), sumK = 0, sumT = 0, sumKK = 0, sumKT = 0;
+    uint64_t t0 = tickFrames[0];
+    for (size_t k = 0; k < tickFrames.size(); ++k) {
+        double t = (double)(tickFrames[k] - t0);
+        sumK += k;
+        sumT += t;
+        sumKK += (double)k * k;
+        sumKT += k * t;
+    }
+    double slope = (n * sumKT - sumK * sumT) / (n * sumKK - sumK * sumK);
+    double offset = (sumT - slope * sumK) / n;
+    for (size_t k = 0; k < tickFrames.size(); ++k) {
+        double dev = std::fabs((double)(tickFrames[k] - t0) - (offset + slope * k));
+        if (dev > r.jitterFrames) r.jitterFrames = dev;
+    }
+    r.tempoPpm = (slope / period - 1.0) * 1e6;
+    if (std::fabs(r.tempoPpm) > kMaxTempoPpm) r.failure = "tempo error";
+    else if (r.jitterFrames > mode.maxJitterFrames + mode.maxJitterBlocks * framesPerStep) r.failure = "tick jitter";
+    return r;
+}
+
+static bool simulateStopped(double seconds, int framesPerStep) {
+    NT_hostInstance inst;
+    if (!NT_hostConstruct(inst, NT_hostFactory(0), nullptr)) return false;
+    NT_hostSetParameter(inst, IDX_BPM, 0);
+    uint32_t sent = NT_hostMidiCount();
+    std::vector<float> bus(kNT_hostNumBusses * framesPerStep);
+    uint64_t numSteps = (uint64_t)(seconds * NT_globals.sampleRate) / framesPerStep;
+    bool ticked = false;
+    for (uint64_t i = 0; i < numSteps; ++i) {
+        NT_hostStep(inst, bus.data(), framesPerStep);
+        for (int f = 0; f < framesPerStep; ++f) ticked |= bus[f] != 0.0f;
+    }
+    bool ok = !ticked && NT_hostMidiCount() == sent;
+    NT_hostDestroy(inst);
+    return ok;
+}
+
+// Notes as each port's receiver sees them. The breakout decoder keeps its
+// running status across blocks, as a synth on the DIN cable would.
+struct SwitchCapture {
+    int held[2][16][128];
+    int noteOns[2];
+    uint8_t running;
+    int numData;
+    uint8_t data[2];
+    bool expectStatus;   // the breakout has just been selected
+    const char* failure;
+};
+
+static void switchMessage(SwitchCapture* c, int port, const uint8_t* b) {
+    int ch = b[0] & 15, note = b[1];
+    if ((b[0] & 0xF0) == 0x90 && b[2] > 0) {
+        ++c->held[port][ch][note];
+        ++c->noteOns[port];
+    } else if (c->held[port][ch][note] == 0) {
+        c->failure = "note-off without a note-on";
+    } else {
+        c->held[port][ch][note] = 0;
+    }
+}
+
+static void captureSwitch(void* user, uint32_t destination, const uint8_t* bytes, int length) {
+    SwitchCapture* c = static_cast<SwitchCapture*>(user);
+    if (destination == kNT_destinationUSB && length == 3) {
+        switchMessage(c, 0, bytes);
+        return;
+    }
+    if (destination != kNT_destinationBreakout || length != 1) {
+        c->failure = "malformed message";
+        return;
+    }
+    uint8_t b = bytes[0];
+    if (c->expectStatus && !(b & 0x80)) c->failure = "breakout resumed running status after a switch";
+    c->expectStatus = false;
+    if (b & 0x80) {
+        c->running = b;
+        c->numData = 0;
+        return;
+    }
+    c->data[c->numData++] = b;
+    if (c->numData == 2) {
+        uint8_t m[3] = { c->running, c->data[0], c->data[1] };
+        switchMessage(c, 1, m);
+        c->numData = 0;
+    }
+}
+
+static bool anyHeld(const SwitchCapture& c, int port) {
+    for (int ch = 0; ch < 16; ++ch)
+        for (int note = 0; note < 128; ++note)
+            if (c.held[port][ch][note]) return true;
+    return false;
+}
+
+// 16 sequences at BPM 120 with 100 ms gates, switching MIDI Out a few frames
+// after a tick so every sequence is mid-note: USB, breakout, USB, breakout.
+// The old port must be silent straight after each switch.
+static const char* simulateMidiOutSwitch(int framesPerStep) {
+    static SwitchCapture cap;
+    std::memset(&cap, 0, sizeof(cap));
+    NT_hostSetMidiHook(captureSwitch, &cap);
+    NT_hostInstance inst;
+    if (!NT_hostConstruct(inst, NT_hostFactory(0), nullptr)) return "construct failed";
+    Plugin* self = static_cast<Plugin*>(inst.algorithm);
+    for (int s = 0; s < self->lanes.numSeqs; ++s)
+        NT_hostSetParameter(inst, IDX_SEQ_BASE + s * SEQ_NUM_PARAMS + SEQ_GATE, 100);
+    NT_hostSetParameter(inst, IDX_BPM, 120);
+
+    const uint64_t sr = NT_globals.sampleRate, tickFrames = sr / 8;
+    const uint64_t endAt = 4 * sr, stopAt = 3 * sr;
+    std::vector<float> bus(kNT_hostNumBusses * framesPerStep);
+    int port = 0;
+    uint64_t nextSwitch = tickFrames * 4 + 2 * framesPerStep;
+    for (uint64_t start = 0; start < endAt && !cap.failure; start += framesPerStep) {
+        if (start >= nextSwitch && start < stopAt) {
+            if (!anyHeld(cap, port)) {
+                cap.failure = "no notes held at the switch";
+                break;
+            }
+            port ^= 1;
+            cap.expectStatus = port == 1;
+            NT_hostSetParameter(inst, IDX_MIDI_OUT, port);
+            if (anyHeld(cap, port ^ 1)) cap.failure = "note left sounding on the old port";
+            nextSwitch += tickFrames * 5;
+        }
+        if (start == stopAt) NT_hostSetParameter(inst, IDX_BPM, 0);
+        NT_hostStep(inst, bus.data(), framesPerStep);
+    }
+    NT_hostDestroy(inst);
+    NT_hostSetMidiHook(nullptr, nullptr);
+    if (cap.failure) return cap.failure;
+    if (anyHeld(cap, 0) || anyHeld(cap, 1)) return "note held after the clock stopped";
+    if (!cap.noteOns[0] || !cap.noteOns[1]) return "a port got no notes";
+    return nullptr;
+}
+
+// 120 BPM at 4 ticks per pulse on two busses, the second a third of a pulse
+// later.
+// Clock Input moves from the first to the second just after an edge. The
+// first edge on the new bus has no period yet, so it ticks alone; from the
+// second on, every interval must be a tick to within two frames, as in the
+// sweep.
+static const char* simulateClockInRepatch(int framesPerStep) {
+    const int kTicksPerPulse = 4;
+    const uint64_t sr = NT_globals.sampleRate, tickFrames = sr / 8;
+    const uint64_t pulseFrames = tickFrames * kTicksPerPulse;
+    const uint64_t moveAt = pulseFrames * 5 + kPulseFrames, endAt = pulseFrames * 12;
+    const uint64_t lag = pulseFrames / 3;
+    const uint64_t settledAt = moveAt + lag + pulseFrames;   // second edge on the new bus
+
+    NT_hostInstance inst;
+    if (!NT_hostConstruct(inst, NT_hostFactory(0), nullptr)) return "construct failed";
+    NT_hostSetParameter(inst, IDX_BPM, 0);
+    NT_hostSetParameter(inst, IDX_PULSE_TICKS, kTicksPerPulse);
+    NT_hostSetParameter(inst, IDX_CLOCK_IN, kClockInBus + 1);
+
+    std::vector<float> bus(kNT_hostNumBusses * framesPerStep);
+    const char* failure = nullptr;
+    uint64_t lastTick = 0;
+    int ticks = 0;
+    bool moved = false;
+    for (uint64_t start = 0; start < endAt && !failure; start += framesPerStep) {
+        if (!moved && start >= moveAt) {
+            NT_hostSetParameter(inst, IDX_CLOCK_IN, kClockInBus + 2);
+            moved = true;
+        }
+        std::memset(bus.data(), 0, framesPerStep * sizeof(float));
+        float* a = bus.data() + kClockInBus * framesPerStep;
+        float* b = a + framesPerStep;
+        for (int f = 0; f < framesPerStep; ++f) {
+            uint64_t t = start + f;
+            a[f] = (t % pulseFrames < (uint64_t)kPulseFrames) ? 5.0f : 0.0f;
+            b[f] = ((t + pulseFrames - lag) % pulseFrames < (uint64_t)kPulseFrames) ? 5.0f : 0.0f;
+        }
+        NT_hostStep(inst, bus.data(), framesPerStep);
+        for (int f = 0; f < framesPerStep && !failure; ++f) {
+            if (bus[f] == 0.0f) continue;
+            uint64_t t = start + f, gap = t - lastTick;
+            if (ticks > 0 && gap < tickFrames / 2) failure = "ticks bunched after moving Clock Input";
+            else if (t > settledAt && (gap + 2 < tickFrames || gap > tickFrames + 2))
+                failure = "tick interval off after moving Clock Input";
+            lastTick = t;
+            ++ticks;
+        }
+    }
+    NT_hostDestroy(inst);
+    if (!failure && lastTick + tickFrames + 2 < endAt) failure = "stopped ticking after moving Clock Input";
+    return failure;
+}
+
+// Clocks arrive between step() calls, each stamped with its own frame, as
+// the module's MIDI input would deliver them. Every clock plays one block
+// after it arrived, so from the second tick after turning on, every interval
+// must be six clocks to the frame.
+static const char* simulateMidiClockToggle(int framesPerStep) {
+    const uint32_t clockFrames = 1000;   // 120 BPM at 48 kHz, 24 PPQN
+    const uint32_t tickFrames = clockFrames * MIDI_CLOCKS_PER_TICK;
+    const uint64_t sr = NT_globals.sampleRate;
+    const uint64_t offAt = 2 * sr, onAt = 4 * sr, endAt = 8 * sr;
+
+    NT_hostInstance inst;
+    if (!NT_hostConstruct(inst, NT_hostFactory(0), nullptr)) return "construct failed";
+    NT_hostSetParameter(inst, IDX_BPM, 0);
+    NT_hostSetParameter(inst, IDX_MIDI_CLOCK, 1);
+    NT_hostSetCycleFrame(0);
+    NT_hostMidiRealtime(inst, 0xFA);
+
+    std::vector<float> bus(kNT_hostNumBusses * framesPerStep);
+    const char* failure = nullptr;
+    uint64_t nextClock = 0, lastTick = 0;
+    int ticksSinceOn = 0;
+    for (uint64_t start = 0; start < endAt && !failure; start += framesPerStep) {
+        bool on = start < offAt || start >= onAt;
+        if (start == onAt) ticksSinceOn = 0;
+        NT_hostSetParameter(inst, IDX_MIDI_CLOCK, on);
+        for (; nextClock < start; nextClock += clockFrames) {
+            NT_hostSetCycleFrame(nextClock);
+            NT_hostMidiRealtime(inst, 0xF8);
+        }
+
+        std::memset(bus.data(), 0, framesPerStep * sizeof(float));
+        NT_hostSetCycleFrame(start);
+        NT_hostStep(inst, bus.data(), framesPerStep);
+
+        for (int f = 0; f < framesPerStep && !failure; ++f) {
+            if (bus[f] == 0.0f) continue;
+            uint64_t t = start + f, gap = t - lastTick;
+            if (!on) failure = "ticked with MIDI Clock off";
+            else if (ticksSinceOn > 0 && gap < tickFrames / 2) failure = "ticks bunched after turning on";
+            else if (ticksSinceOn > 0 && (gap + 1 < tickFrames || gap > tickFrames + 1))
+                failure = "tick interval off by more than a frame";
+            lastTick = t;
+            ++ticksSinceOn;
+        }
+    }
+    // One tick per six clocks since turning on, give or take one.
+    uint64_t expected = (endAt - onAt) / tickFrames;
+    if (!failure && (ticksSinceOn + 1 < (int)expected || ticksSinceOn > (int)expected + 1))
+        failure = "wrong tick count after turning on";
+    NT_hostDestroy(inst);
+    NT_hostRealCycleClock();
+    return failure;
+}
+
+// Calls tick() directly, so only the sequence update, note-off bookkeeping
+// and MIDI queueing are timed; the port itself is a no-op. Also returns the
+// instance's SRAM and DTC.
+static double nsPerTick(int numSeqs, int framesPerStep, int n, uint32_t& sram, uint32_t& dtc) {
+    int32_t specs[NUM_SPECS] = { numSeqs, specifications[SPEC_STEPS].def };
+    NT_hostInstance inst;
+    if (!NT_hostConstruct(inst, NT_hostFactory(0), specs)) return 0.0;
+    sram = inst.req.sram;
+    dtc = inst.req.dtc;
+    Plugin* self = static_cast<Plugin*>(inst.algorithm);
+    NT_hostSetParameter(inst, IDX_RANDOMIZE, 1);
+    std::vector<float> bus(kNT_hostNumBusses * framesPerStep);
+
+    auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < n; ++i) {
+        self->tick(bus.data(), framesPerStep, 0);
+        self->frameTime += framesPerStep;
+    }
+    self->flushMidi();
+    auto t1 = std::chrono::steady_clock::now();
+    NT_hostDestroy(inst);
+    return std::chrono::duration<double, std::nano>(t1 - t0).count() / n;
+}
+
+static void usage(const char* argv0) {
+    std::fprintf(stderr, "usage: %s [-s secondsPerBpm] [-b framesPerStep]\n", argv0);
+    std::exit(2);
+}
+
+int main(int argc, char** argv) {
+    double seconds = 300.0;
+    int framesPerStep = 128;
+    for (int i = 1; i < argc; ++i) {
+        if (i + 1 >= argc) usage(argv[0]);
+        const char* a = argv[i];
+        const char* val = argv[++i];
+        if (!std::strcmp(a, "-s")) seconds = std::atof(val);
+        else if (!std::strcmp(a, "-b")) framesPerStep = std::atoi(val);
+        else usage(argv[0]);
+    }
+    if (seconds <= 0.0 || framesPerStep <= 0 || (framesPerStep & 3)) usage(argv[0]);
+
+    NT_hostConfigure(48000, framesPerStep);
+    const double usPerFrame = 1e6 / NT_globals.sampleRate;
+    Capture cap;
+    cap.breakoutMessages = cap.breakoutBytes = 0;
+    cap.malformed = 0;
+    NT_hostSetMidiHook(captureMidi, &cap);
+
+    // Ticks between Clock Input edges are placed from an edge up to half a
+    // frame off the grid and a whole-frame period estimate, then rounded, so
+    // they get two frames. The first edge has no period yet, so its pulse
+    // has one tick. MIDI clocks carry their arrival time and are rounded to
+    // whole frames, so following them gets one frame like free-running.
+    const SimMode modes[] = {
+        { "USB, free-running", 0, CLOCK_FREE, 1, 1, 0, 1.0, 0.0 },
+        { "breakout, free-running", 1, CLOCK_FREE, 1, 7, 0, 1.0, 0.0 },
+        { "USB, Clock Input 1 tick/pulse", 0, CLOCK_INPUT, 1, 7, 0, 1.0, 0.0 },
+        { "USB, Clock Input 4 ticks/pulse", 0, CLOCK_INPUT, 4, 7, 1, 2.0, 0.0 },
+        { "breakout, MIDI clock", 1, CLOCK_MIDI, 1, 7, 0, 1.0, 0.0 },
+    };
+
+    int failures = 0;
+    for (const SimMode& mode : modes) {
+        uint64_t totalTicks = 0, totalEvents = 0;
+        double worstPpm = 0.0, worstJitter = 0.0;
+        int worstPpmBpm = 0, worstJitterBpm = 0;
+        for (int bpm = 1; bpm <= 400; bpm += mode.bpmStride) {
+            BpmResult r = simulateBpm(mode, bpm, specifications[SPEC_SEQS].def, seconds, framesPerStep, cap);
+            if (r.failure) {
+                std::printf("%s, BPM %3d: FAIL %s\n", mode.name, bpm, r.failure);
+                ++failures;
+                continue;
+            }
+            totalTicks += r.ticks;
+            totalEvents += r.events;
+            if (std::fabs(r.tempoPpm) > std::fabs(worstPpm)) { worstPpm = r.tempoPpm; worstPpmBpm = bpm; }
+            if (r.jitterFrames > worstJitter) { worstJitter = r.jitterFrames; worstJitterBpm = bpm; }
+        }
+        std::printf("%s, BPM 1..400 step %d: %llu ticks, %llu note events\n", mode.name, mode.bpmStride,
+                    (unsigned long long)totalTicks, (unsigned long long)totalEvents);
+        std::printf("  worst tempo error %+.1f ppm at BPM %d (limit %.0f)\n", worstPpm, worstPpmBpm, kMaxTempoPpm);
+        std::printf("  worst jitter %.2f us (%.2f frames) at BPM %d\n",
+                    worstJitter * usPerFrame, worstJitter, worstJitterBpm);
+    }
+    std::printf("%d frames per step; breakout: %llu messages in %llu bytes\n", framesPerStep,
+                (unsigned long long)cap.breakoutMessages, (unsigned long long)cap.breakoutBytes);
+    if (cap.breakoutBytes >= 3 * cap.breakoutMessages) {
+        std::printf("FAIL breakout running status not used\n");
+        ++failures;
+    }
+
+    // Sequences past 16 share channels with 1-16.
+    const int sharedBpms[] = { 30, 120, 400 };
+    uint64_t sharedEvents = 0;
+    for (int bpm : sharedBpms) {
+        BpmResult r = simulateBpm(modes[0], bpm, MAX_SEQS, seconds, framesPerStep, cap);
+        if (r.failure) {
+            std::printf("BPM %3d, %d sequences: FAIL %s\n", bpm, MAX_SEQS, r.failure);
+            ++failures;
+        }
+        sharedEvents += r.events;
+    }
+    std::printf("%d sequences on 16 channels at BPM 30, 120, 400: %llu note events\n", MAX_SEQS,
+                (unsigned long long)sharedEvents);
+    if (cap.malformed) {
+        std::printf("FAIL %d malformed messages\n", cap.malformed);
+        ++failures;
+    }
+
+    NT_hostSetMidiHook(nullptr, nullptr);
+    if (simulateStopped(seconds, framesPerStep)) {
+        std::printf("BPM 0: silent\n");
+    } else {
+        std::printf("BPM 0: FAIL ticked or sent MIDI\n");
+        ++failures;
+    }
+
+    const char* switchFailure = simulateMidiOutSwitch(framesPerStep);
+    if (switchFailure) {
+        std::printf("MIDI Out switch: FAIL %s\n", switchFailure);
+        ++failures;
+    } else {
+        std::printf("MIDI Out switch: old port released\n");
+    }
+
+    const char* repatchFailure = simulateClockInRepatch(framesPerStep);
+    if (repatchFailure) {
+        std::printf("Clock Input moved: FAIL %s\n", repatchFailure);
+        ++failures;
+    } else {
+        std::printf("Clock Input moved: relocked\n");
+    }
+
+    const char* midiFailure = simulateMidiClockToggle(framesPerStep);
+    if (midiFailure) {
+        std::printf("MIDI clock off/on: FAIL %s\n", midiFailure);
+        ++failures;
+    } else {
+        std::printf("MIDI clock off/on: relocked\n");
+    }
+
+    const int seqCounts[] = { 1, 16, MAX_SEQS };
+    for (int numSeqs : seqCounts) {
+        uint32_t sram = 0, dtc = 0;
+        double ns = nsPerTick(numSeqs, framesPerStep, 1 << 20, sram, dtc);
+        std::printf("%2d sequences: %8.1f ns/tick, %6u bytes SRAM, %4u bytes DTC\n", numSeqs, ns, sram, dtc);
+    }
+
+    if (failures) std::printf("%d failures\n", failures);
+    return failures ? 1 : 0;
+}
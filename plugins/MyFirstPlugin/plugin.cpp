@@ -1,108 +1,744 @@
 #include "api/distingnt/api.h"
 #include <stdint.h>
-#include <stdlib.h>
+#include <atomic>
+#include <new>
 
-#define MAX_SEQS 16
-#define MAX_STEPS 16
+// Upper limits for the Sequences and Max Steps specifications. 40 sequences
+// keeps every parameter index within the uint8_t a page can hold. Sequence n
+// plays on MIDI channel n % 16 + 1, so past 16 sequences channels are shared.
+#define MAX_SEQS 40
+#define MAX_STEPS 256
+#define MIDI_EVENTS_PER_SEQ 4   // a note-off and a note-on for two ticks a block
 
+// Clock input hysteresis, in volts.
+#define CLOCK_IN_HIGH 1.0f
+#define CLOCK_IN_LOW 0.5f
+
+#define REALTIME_RING_SIZE 64   // power of two
+#define MIDI_CLOCKS_PER_TICK 6  // 24 PPQN, 16th-note ticks
+
+// Global parameters first, then one block per sequence, so an instance's
+// parameters are a prefix of the full table.
 enum {
     IDX_RANDOMIZE,
-    IDX_INCLUDE_BASE = 1,
-    IDX_MIDI_OUT = IDX_INCLUDE_BASE + MAX_SEQS,
+    IDX_MIDI_OUT,
     IDX_BPM,
     IDX_CLOCK_BUS,
-    IDX_PARAM_BASE
+    IDX_SEED,
+    IDX_CLOCK_IN,
+    IDX_PULSE_TICKS,
+    IDX_MIDI_CLOCK,
+    IDX_SEQ_BASE
 };
 
+enum { SEQ_INCLUDE, SEQ_STEPS, SEQ_DIV, SEQ_RANGE, SEQ_DIR, SEQ_GATE, SEQ_NUM_PARAMS };
+
+enum { MAX_PARAMS = IDX_SEQ_BASE + MAX_SEQS * SEQ_NUM_PARAMS };
+
+static_assert(MAX_PARAMS <= 256, "page parameter indices are uint8_t");
+
+enum { SPEC_SEQS, SPEC_STEPS, NUM_SPECS };
+
 enum DirMode { FWD, BWD, RND };
 
-struct Sequence {
-    int steps;
-    int div;
-    int range;
-    DirMode dir;
-    int pos;
-    int divCounter;
-    int data[MAX_STEPS];
+// xorshift32: per-instance, reentrant, and a handful of cycles per draw.
+struct Rng {
+    uint32_t state;
+
+    void seed(uint32_t s) {
+        // Spread nearby seeds apart; xorshift must never hold zero.
+        s = (s + 0x9E3779B9u) * 0x85EBCA6Bu;
+        s ^= s >> 13;
+        s *= 0xC2B2AE35u;
+        s ^= s >> 16;
+        state = s ? s : 1;
+    }
+
+    uint32_t next() {
+        uint32_t x = state;
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        return state = x;
+    }
+
+    // Uniform in [0, n) by multiply-shift instead of a divide.
+    uint32_t below(uint32_t n) {
+        return (uint32_t)(((uint64_t)next() * n) >> 32);
+    }
+};
+
+// Pending note-offs, at most one per sequence, kept as a list ordered by
+// deadline. A new note-off only walks back past sequences with a longer gate
+// that fired recently, so with equal gates it goes straight to the tail, and
+// retriggering a sequence just unlinks it first: both are O(1). Deadlines are
+// in frames since construct() and are compared by signed difference so the
+// counter may wrap.
+struct NoteOffQueue {
+    uint32_t* deadline;
+    uint8_t* note;
+    int8_t* prev;
+    int8_t* next;
+    bool* pending;
+    int8_t head, tail;
+    int numSeqs;
+
+    // A uint32_t per sequence in deadlines, four bytes per sequence in bytes.
+    void carve(uint32_t* deadlines, uint8_t* bytes, int seqs) {
+        deadline = deadlines;
+        note = bytes;
+        prev = reinterpret_cast<int8_t*>(bytes + seqs);
+        next = reinterpret_cast<int8_t*>(bytes + 2 * seqs);
+        pending = reinterpret_cast<bool*>(bytes + 3 * seqs);
+        numSeqs = seqs;
+    }
+
+    void clear() {
+        head = tail = -1;
+        for (int seq = 0; seq < numSeqs; ++seq) pending[seq] = false;
+    }
+
+    static bool due(uint32_t deadline, uint32_t now) {
+        return (int32_t)(deadline - now) <= 0;
+    }
+
+    void remove(int seq) {
+        if (prev[seq] >= 0) next[prev[seq]] = next[seq]; else head = next[seq];
+        if (next[seq] >= 0) prev[next[seq]] = prev[seq]; else tail = prev[seq];
+        pending[seq] = false;
+    }
+
+    void push(int seq, int n, uint32_t when) {
+        // Walk back only past entries due later: longer gates, or any gate
+        // just after it has been shortened.
+        int after = tail;
+        while (after >= 0 && (int32_t)(deadline[after] - when) > 0) after = prev[after];
+        prev[seq] = after;
+        next[seq] = (after >= 0) ? next[after] : head;
+        if (next[seq] >= 0) prev[next[seq]] = seq; else tail = seq;
+        if (after >= 0) next[after] = seq; else head = seq;
+        deadline[seq] = when;
+        note[seq] = n;
+        pending[seq] = true;
+    }
+};
+
+// First frame in [from, to) at or above threshold (Above) or below it, else to.
+// Four samples are tested per branch, so a quiet block costs a quarter of
+// the branches of a per-sample scan.
+template <bool Above>
+static int findCrossing(const float* x, int from, int to, float threshold) {
+    int i = from;
+    for (; i < to && (i & 3); ++i) {
+        if (Above ? x[i] >= threshold : x[i] < threshold) return i;
+    }
+    for (; i + 4 <= to; i += 4) {
+        bool hit = Above
+            ? (x[i] >= threshold) | (x[i + 1] >= threshold) | (x[i + 2] >= threshold) | (x[i + 3] >= threshold)
+            : (x[i] < threshold) | (x[i + 1] < threshold) | (x[i + 2] < threshold) | (x[i + 3] < threshold);
+        if (hit) break;
+    }
+    for (; i < to; ++i) {
+        if (Above ? x[i] >= threshold : x[i] < threshold) return i;
+    }
+    return to;
+}
+
+// Realtime bytes from midiRealtime() to step(), each with the cycle count it
+// arrived at. One producer and one consumer, each owning one index, so
+// neither side ever waits; if step() falls a whole ring behind, new bytes are
+// dropped.
+struct RealtimeRing {
+    uint8_t bytes[REALTIME_RING_SIZE];
+    uint32_t stamps[REALTIME_RING_SIZE];
+    std::atomic<uint32_t> head;   // written only by midiRealtime()
+    std::atomic<uint32_t> tail;   // written only by step()
+
+    void clear() {
+        head.store(0, std::memory_order_relaxed);
+        tail.store(0, std::memory_order_relaxed);
+    }
+
+    bool push(uint8_t b, uint32_t stamp) {
+        uint32_t h = head.load(std::memory_order_relaxed);
+        if (h - tail.load(std::memory_order_acquire) == REALTIME_RING_SIZE) return false;
+        bytes[h & (REALTIME_RING_SIZE - 1)] = b;
+        stamps[h & (REALTIME_RING_SIZE - 1)] = stamp;
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    // The oldest byte, left in the ring until drop().
+    bool peek(uint8_t& b, uint32_t& stamp) const {
+        uint32_t t = tail.load(std::memory_order_relaxed);
+        if (t == head.load(std::memory_order_acquire)) return false;
+        b = bytes[t & (REALTIME_RING_SIZE - 1)];
+        stamp = stamps[t & (REALTIME_RING_SIZE - 1)];
+        return true;
+    }
+
+    void drop() {
+        tail.store(tail.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+};
+
+struct MidiEvent {
+    uint32_t time;
+    uint8_t status, data1, data2;
 };
 
+// MIDI produced during one step(), sent in frame-time order when the block
+// ends. Events nearly always arrive in order, so the insertion walk stops at
+// once; equal times keep their arrival order. Room for MIDI_EVENTS_PER_SEQ
+// per sequence; a fuller block flushes early, still in order.
+struct MidiQueue {
+    MidiEvent* events;
+    int capacity;
+    int count;
+
+    void push(uint32_t time, uint8_t status, uint8_t data1, uint8_t data2) {
+        int i = count++;
+        while (i > 0 && (int32_t)(events[i - 1].time - time) > 0) {
+            events[i] = events[i - 1];
+            --i;
+        }
+        events[i] = { time, status, data1, data2 };
+    }
+};
+
+// Sequence state as one byte-wide lane per field, plus the gate in ms, which
+// needs a uint16_t row and so comes first. The rows live in DTC; the step
+// data, numSeqs rows of maxSteps bytes, lives in SRAM. Steps is held as its
+// last index so 256 still fits a byte.
+//
+// The layout is for footprint, not host speed: 9 bytes per sequence instead
+// of a struct of ints keeps even 48 sequences to a few hundred bytes of the
+// small DTC shared by every loaded algorithm, where the M7 reads it without
+// going through the cache. bench_seqtick shows the byte rows slightly slower
+// than the old structs on x86, where both fit in L1; it checks that the two
+// agree but says nothing about the module.
+struct SeqLanes {
+    uint16_t* gate;
+    uint8_t* divCounter;
+    uint8_t* div;
+    uint8_t* pos;
+    uint8_t* last;
+    uint8_t* dir;
+    uint8_t* range;
+    uint8_t* include;
+    uint8_t* data;
+    int numSeqs;
+    int maxSteps;
+
+    static const int kNumRows = 7;   // byte rows, after the gate row
+
+    static constexpr uint32_t rowBytes(int seqs) {
+        return seqs * (sizeof(uint16_t) + kNumRows);
+    }
+
+    // rows must be 2-byte aligned.
+    void carve(uint8_t* rows, uint8_t* steps, int seqs, int stepsPerSeq) {
+        gate = reinterpret_cast<uint16_t*>(rows);
+        rows += seqs * sizeof(uint16_t);
+        divCounter = rows;
+        div = rows + seqs;
+        pos = rows + 2 * seqs;
+        last = rows + 3 * seqs;
+        dir = rows + 4 * seqs;
+        range = rows + 5 * seqs;
+        include = rows + 6 * seqs;
+        data = steps;
+        numSeqs = seqs;
+        maxSteps = stepsPerSeq;
+    }
+};
+
+// Advance every sequence by one tick. Wraps compare against the last step
+// rather than dividing. Returns a bit per sequence that fired, with its note
+// in notes[].
+static uint64_t advanceLanes(const SeqLanes& L, Rng& rngState, bool randomise, uint8_t* notes) {
+    // Byte stores may alias anything, so keep the row pointers in locals.
+    uint8_t* const divCounter = L.divCounter;
+    const uint8_t* const div = L.div;
+    uint8_t* const pos = L.pos;
+    const uint8_t* const last = L.last;
+    const uint8_t* const dir = L.dir;
+    const uint8_t* const range = L.range;
+    const uint8_t* const include = L.include;
+    uint8_t* const data = L.data;
+    const int numSeqs = L.numSeqs, stride = L.maxSteps;
+
+    Rng rng = rngState;
+    uint64_t fired = 0;
+    for (int seq = 0; seq < numSeqs; ++seq) {
+        int count = divCounter[seq] + 1;
+        if (count < div[seq]) {
+            divCounter[seq] = count;
+            continue;
+        }
+        divCounter[seq] = 0;
+        fired |= (uint64_t)1 << seq;
+
+        int idx = pos[seq];
+        uint8_t* steps = data + seq * stride;
+        if (randomise && include[seq]) {
+            steps[idx] = rng.below(range[seq] + 1);
+        }
+        notes[seq] = steps[idx];
+
+        int end = last[seq];
+        if (dir[seq] == FWD) idx = (idx >= end) ? 0 : idx + 1;
+        else if (dir[seq] == BWD) idx = (idx == 0 || idx > end) ? end : idx - 1;
+        else idx = rng.below(end + 1);
+        pos[seq] = idx;
+    }
+    rngState = rng;
+    return fired;
+}
+
 struct Plugin : _NT_algorithm {
-    Sequence seqs[MAX_SEQS];
-    bool includes[MAX_SEQS];
+    SeqLanes lanes;
+    _NT_parameterPage pages[4];
+    _NT_parameterPages pageList;
     bool randomise;
-    int clockCounter;
+    Rng rng;
+    NoteOffQueue noteOffs;
+    uint8_t* heldCount;     // [16][128] sequences holding each note, past 16 sequences only
+    MidiQueue midiOut;
+    uint32_t midiDest;
+    uint32_t tickPhase;     // position within the current 16th, wraps at 2^32
+    uint32_t frameTime;     // frames since construct(), at the start of this block
+    uint32_t gateScale;     // frames per ms, 16.16, for this block's sample rate
 
-    void step(float* busFrames, int numFramesBy4) {
-        int bpm = v[IDX_BPM];
-        float freq = bpm / 60.0f * 16.0f;
-        int interval = (int)(NT_globals.sampleRate / freq / 4);
-
-        clockCounter++;
-        if (clockCounter >= interval) {
-            clockCounter = 0;
-
-            for (int ch = 0; ch < MAX_SEQS; ++ch) {
-                Sequence& s = seqs[ch];
-                if (++s.divCounter >= s.div) {
-                    s.divCounter = 0;
-
-                    int idx = s.pos;
-                    if (randomise && includes[ch]) {
-                        s.data[idx] = rand() % (s.range + 1);
-                    }
-
-                    int note = s.data[idx];
-                    NT_sendMidi3ByteMessage(
-                        v[IDX_MIDI_OUT] == 0 ? kNT_destinationUSB : kNT_destinationBreakout,
-                        0x90 | ch, note, 127);
-
-                    if (s.dir == FWD) s.pos = (s.pos + 1) % s.steps;
-                    else if (s.dir == BWD) s.pos = (s.pos + s.steps - 1) % s.steps;
-                    else if (s.dir == RND) s.pos = rand() % s.steps;
+    // External clock follower
+    bool clockInHigh;
+    bool clockInSeen;          // lastPulse is valid
+    uint32_t lastPulse;        // frame time of the previous rising edge
+    uint32_t pulsePeriod;      // smoothed frames between edges, 0 until known
+    uint32_t extTicks;         // Ticks/Pulse at the previous edge
+    int extRemaining;          // of those, still to play before the next
+
+    // MIDI clock follower. midiRealtime() stamps every byte with the CPU
+    // cycle counter; step() converts the stamps to frames against its own
+    // start times and plays each clock one block after it arrived, so ticks
+    // keep the clock's spacing to the frame. A 16th is every sixth clock, so
+    // nothing is left to interpolate between them.
+    RealtimeRing realtime;
+    uint32_t stepCycles;       // cycle count at the start of the previous step()
+    uint32_t stepFrames;       // and its length, 0 before the first
+    float framesPerCycle;      // smoothed, 0 until two step()s have been seen
+    bool midiRunning;
+    uint32_t midiClockCount;   // clocks played since Start
+
+    // Reseeding also redraws the starting notes, so a seed fully
+    // determines the pattern.
+    void reseed(uint32_t seed) {
+        rng.seed(seed);
+        int n = lanes.numSeqs * lanes.maxSteps;
+        for (int i = 0; i < n; ++i) lanes.data[i] = rng.below(128);
+    }
+
+    // Gates are in ms; tick() scales them by this, once per note.
+    static uint32_t frames16PerMs() {
+        return (uint32_t)(((uint64_t)NT_globals.sampleRate << 16) / 1000);
+    }
+
+    // One 16th-note tick per wrap of tickPhase, so BPM / 60 * 4 wraps per second.
+    uint32_t tickIncrement() const {
+        double ticksPerSecond = v[IDX_BPM] / 60.0 * 4.0;
+        return (uint32_t)(ticksPerSecond / NT_globals.sampleRate * 4294967296.0);
+    }
+
+    void queueMidi(uint32_t time, uint8_t status, uint8_t data1, uint8_t data2) {
+        if (midiOut.count == midiOut.capacity) flushMidi();
+        midiOut.push(time, status, data1, data2);
+    }
+
+    // The breakout is a 31.25 kbaud DIN port, so it gets running status:
+    // note-offs go out as velocity-0 note-ons and a repeated status byte is
+    // dropped. Running status restarts with every flush in case something
+    // else wrote to the port in between. USB gets whole messages.
+    void flushMidi() {
+        if (midiDest == kNT_destinationBreakout) {
+            uint8_t running = 0;
+            for (int i = 0; i < midiOut.count; ++i) {
+                const MidiEvent& e = midiOut.events[i];
+                uint8_t status = e.status, data2 = e.data2;
+                if ((status & 0xF0) == 0x80) {
+                    status = 0x90 | (status & 0x0F);
+                    data2 = 0;
+                }
+                if (status != running) {
+                    NT_sendMidiByte(midiDest, status);
+                    running = status;
                 }
+                NT_sendMidiByte(midiDest, e.data1);
+                NT_sendMidiByte(midiDest, data2);
+            }
+        } else {
+            for (int i = 0; i < midiOut.count; ++i) {
+                const MidiEvent& e = midiOut.events[i];
+                NT_sendMidi3ByteMessage(midiDest, e.status, e.data1, e.data2);
             }
+        }
+        midiOut.count = 0;
+    }
 
-            int bus = v[IDX_CLOCK_BUS] - 1;
-            if (bus >= 0 && bus < 28) {
-                busFrames[bus * NT_globals.maxFramesPerStep] = 1.0f;
+    // Past 16 sequences the channels are shared in turn, so two sequences can
+    // hold the same note on one channel. The note-off goes out only when the
+    // last holder releases, so one sequence never cuts the other's note short.
+    // Up to 16 each sequence has its own channel and there is nothing to count.
+    void noteOn(int seq, int n, uint32_t time) {
+        if (heldCount) ++heldCount[(seq & 15) * 128 + n];
+        queueMidi(time, 0x90 | (seq & 15), n, 127);
+    }
+
+    void noteOff(int seq, uint32_t time) {
+        int n = noteOffs.note[seq];
+        if (!heldCount || --heldCount[(seq & 15) * 128 + n] == 0) queueMidi(time, 0x80 | (seq & 15), n, 0);
+        noteOffs.remove(seq);
+    }
+
+    // Notes left on the old port when MIDI Out changes would never end, so
+    // every pending note-off goes out there now. flushMidi() restarts running
+    // status, so the new port's first message carries its status byte.
+    void setMidiDest(uint32_t dest) {
+        if (dest == midiDest) return;
+        while (noteOffs.head >= 0) noteOff(noteOffs.head, frameTime);
+        flushMidi();
+        midiDest = dest;
+    }
+
+    // Release every note whose gate has ended at or before frame time now.
+    void releaseDue(uint32_t now) {
+        while (noteOffs.head >= 0 && NoteOffQueue::due(noteOffs.deadline[noteOffs.head], now)) {
+            int seq = noteOffs.head;
+            noteOff(seq, noteOffs.deadline[seq]);
+        }
+    }
+
+    void tick(float* busFrames, int numFrames, int frame) {
+        uint32_t now = frameTime + frame;
+        releaseDue(now);
+
+        uint8_t notes[MAX_SEQS];
+        uint64_t fired = advanceLanes(lanes, rng, randomise, notes);
+        for (uint64_t m = fired; m; m &= m - 1) {
+            int seq = __builtin_ctzll(m);
+            if (noteOffs.pending[seq]) noteOff(seq, now);
+            noteOn(seq, notes[seq], now);
+            uint32_t gate = (uint32_t)(((uint64_t)lanes.gate[seq] * gateScale) >> 16);
+            noteOffs.push(seq, notes[seq], now + (gate ? gate : 1));
+        }
+
+        int bus = v[IDX_CLOCK_BUS] - 1;
+        if (bus >= 0 && bus < 28) {
+            busFrames[bus * numFrames + frame] = 1.0f;
+        }
+    }
+
+    // Advance phase frame by frame over [from, to), jumping straight from one
+    // wrap to the next and ticking at each, so every tick lands on its own
+    // frame whatever the block size. Stops after limit ticks if limit >= 0.
+    // A zero increment gives no ticks.
+    int runTicks(float* busFrames, int numFrames, uint32_t& phase, uint32_t inc,
+                 int from, int to, int limit) {
+        int fired = 0;
+        int frame = from;
+        while (inc != 0 && fired != limit) {
+            uint32_t untilWrap = (0xFFFFFFFFu - phase) / inc;
+            if ((uint64_t)frame + untilWrap >= (uint64_t)to) {
+                phase += (uint32_t)(to - frame) * inc;
+                break;
             }
+            frame += untilWrap;
+            phase += (untilWrap + 1) * inc;
+            tick(busFrames, numFrames, frame);
+            ++fired;
+            ++frame;
         }
+        return fired;
     }
-};
 
-static const char* dirLabels[] = { "FWD", "BWD", "RND" };
+    // Forget the input's level, last edge and period, so an edge on a newly
+    // patched bus is not measured against one on the old bus.
+    void resetClockIn() {
+        clockInHigh = false;
+        clockInSeen = false;
+        lastPulse = 0;
+        pulsePeriod = 0;
+        extTicks = 1;
+        extRemaining = 0;
+    }
 
-static _NT_parameter parameters[80];
-static _NT_parameterPage pages[4];
-static uint8_t paramIndices[80];
+    // A rising edge ticks at once. Once two edges have been seen, the other
+    // Ticks/Pulse - 1 ticks are spread over the estimated period; an early
+    // edge drops whatever is left and resynchronises.
+    void clockPulse(float* busFrames, int numFrames, int frame) {
+        uint32_t now = frameTime + frame;
+        if (clockInSeen) {
+            uint32_t measured = now - lastPulse;
+            // Follow small drift smoothly, jump on a real tempo change.
+            if (pulsePeriod == 0 || measured > pulsePeriod + pulsePeriod / 4 ||
+                measured < pulsePeriod - pulsePeriod / 4) {
+                pulsePeriod = measured;
+            } else {
+                pulsePeriod = (pulsePeriod * 3 + measured) / 4;
+            }
+        }
+        lastPulse = now;
+        clockInSeen = true;
 
-static void buildParams() {
-    parameters[IDX_RANDOMIZE] = { "Randomise!", 0, 1, 0, kNT_typeBoolean, 0, nullptr };
+        tick(busFrames, numFrames, frame);
 
-    for (int i = 0; i < MAX_SEQS; ++i) {
-        parameters[IDX_INCLUDE_BASE + i] = { ("Include " + std::to_string(i + 1)).c_str(), 0, 1, 1, kNT_typeBoolean, 0, nullptr };
+        uint32_t ticks = v[IDX_PULSE_TICKS];
+        extRemaining = 0;
+        if (pulsePeriod > 0 && ticks > 1) {
+            extTicks = ticks;
+            extRemaining = ticks - 1;
+        }
     }
 
-    parameters[IDX_MIDI_OUT] = { "MIDI Out", 0, 1, 0, kNT_unitEnum, 0, nullptr };
-    parameters[IDX_BPM] = { "BPM", 0, 400, 120, kNT_unitBPM, 0, nullptr };
-    parameters[IDX_CLOCK_BUS] = { "Clock Output", 1, 28, 1, kNT_unitAudioOutput, 0, nullptr };
+    // Play the ticks between edges that fall in [from, to). The k-th lands
+    // on the frame nearest k / Ticks of the period after the edge, counted
+    // from the edge itself, so slow clocks do not drift within a pulse.
+    void pulseTicks(float* busFrames, int numFrames, int from, int to) {
+        while (extRemaining > 0) {
+            uint32_t k = extTicks - extRemaining;
+            uint32_t offset = (uint32_t)(((uint64_t)k * pulsePeriod * 2 + extTicks) / (2 * extTicks));
+            int frame = (int32_t)(lastPulse + offset - frameTime);
+            if (frame >= to) break;
+            tick(busFrames, numFrames, frame < from ? from : frame);
+            --extRemaining;
+        }
+    }
 
-    for (int i = 0; i < MAX_SEQS; ++i) {
-        int base = IDX_PARAM_BASE + i * 4;
-        parameters[base] = { ("Steps " + std::to_string(i + 1)).c_str(), 1, 16, 16, kNT_unitNone, 0, nullptr };
-        parameters[base + 1] = { ("Div " + std::to_string(i + 1)).c_str(), 1, 32, 1, kNT_unitNone, 0, nullptr };
-        parameters[base + 2] = { ("Range " + std::to_string(i + 1)).c_str(), 0, 127, 127, kNT_unitMIDINote, 0, nullptr };
-        parameters[base + 3] = { ("Dir " + std::to_string(i + 1)).c_str(), 0, 2, 0, kNT_unitEnum, 0, dirLabels };
+    void followClock(float* busFrames, int numFrames, const float* in) {
+        int frame = 0;
+        while (frame < numFrames) {
+            int edge = numFrames;
+            if (clockInHigh) {
+                int fall = findCrossing<false>(in, frame, numFrames, CLOCK_IN_LOW);
+                if (fall < numFrames) edge = findCrossing<true>(in, fall, numFrames, CLOCK_IN_HIGH);
+                clockInHigh = (fall == numFrames) || (edge < numFrames);
+            } else {
+                edge = findCrossing<true>(in, frame, numFrames, CLOCK_IN_HIGH);
+                clockInHigh = edge < numFrames;
+            }
+
+            pulseTicks(busFrames, numFrames, frame, edge);
+            if (edge == numFrames) break;
+            clockPulse(busFrames, numFrames, edge);
+            frame = edge + 1;
+        }
+    }
+
+    // Audio frames per CPU cycle, measured between step() starts. Follows
+    // drift smoothly and jumps on a real change, as clockPulse() does.
+    void trackCycles(uint32_t now, int numFrames) {
+        uint32_t cycles = now - stepCycles;
+        if (stepFrames != 0 && cycles != 0) {
+            float measured = (float)stepFrames / (float)cycles;
+            if (framesPerCycle == 0.0f || measured > framesPerCycle * 1.25f ||
+                measured < framesPerCycle * 0.75f) {
+                framesPerCycle = measured;
+            } else {
+                framesPerCycle += (measured - framesPerCycle) * (1.0f / 16.0f);
+            }
+        }
+        stepCycles = now;
+        stepFrames = numFrames;
+    }
+
+    void midiRealtimeByte(uint8_t b, float* busFrames, int numFrames, int frame) {
+        switch (b) {
+            case 0xF8:
+                if (midiRunning && midiClockCount++ % MIDI_CLOCKS_PER_TICK == 0)
+                    tick(busFrames, numFrames, frame);
+                break;
+            case 0xFA:
+                for (int seq = 0; seq < lanes.numSeqs; ++seq) {
+                    lanes.pos[seq] = 0;
+                    lanes.divCounter[seq] = 0;
+                }
+                midiClockCount = 0;
+                // fall through
+            case 0xFB:
+                midiRunning = true;
+                break;
+            case 0xFC:
+                midiRunning = false;
+                break;
+        }
+    }
+
+    // With MIDI Clock off the ring is still emptied every block, so nothing
+    // stale is played when it is turned on. Only Start/Continue/Stop are
+    // kept, and they do not move the sequences.
+    void discardMidiClock() {
+        uint8_t b;
+        uint32_t stamp;
+        while (realtime.peek(b, stamp)) {
+            realtime.drop();
+            if (b == 0xFA || b == 0xFB) midiRunning = true;
+            else if (b == 0xFC) midiRunning = false;
+        }
+    }
+
+    // A byte stamped (now - stamp) cycles before this step() plays that long
+    // before the block ends. Bytes stamped after now arrived while this
+    // step() ran and wait for the next block.
+    void followMidiClock(float* busFrames, int numFrames, uint32_t now) {
+        int from = 0;
+        uint8_t b;
+        uint32_t stamp;
+        while (realtime.peek(b, stamp)) {
+            uint32_t ago = now - stamp;
+            if ((int32_t)ago < 0) break;
+            realtime.drop();
+            int frame = numFrames - (int)((float)ago * framesPerCycle + 0.5f);
+            if (frame < from) frame = from;
+            if (frame > numFrames - 1) frame = numFrames - 1;
+            midiRealtimeByte(b, busFrames, numFrames, frame);
+            from = frame;
+        }
+    }
+
+    // Free-runs from BPM, follows MIDI clock when MIDI Clock is on, or
+    // follows the Clock Input bus when one is set.
+    // Note-offs that fall between ticks are released in tick(), the rest at
+    // the end of the block.
+    void step(float* busFrames, int numFramesBy4) {
+        int numFrames = numFramesBy4 * 4;
+        gateScale = frames16PerMs();
+
+        uint32_t now = NT_getCpuCycleCount();
+        trackCycles(now, numFrames);
+
+        int inBus = v[IDX_CLOCK_IN] - 1;
+        if (v[IDX_MIDI_CLOCK]) {
+            followMidiClock(busFrames, numFrames, now);
+        } else {
+            discardMidiClock();
+            if (inBus >= 0 && inBus < 28) {
+                followClock(busFrames, numFrames, busFrames + inBus * numFrames);
+            } else {
+                runTicks(busFrames, numFrames, tickPhase, tickIncrement(), 0, numFrames, -1);
+            }
+        }
+        releaseDue(frameTime + numFrames - 1);
+        flushMidi();
+        frameTime += numFrames;
     }
+};
+
+static constexpr const char* dirLabels[] = { "FWD", "BWD", "RND" };
+static constexpr const char* offOnLabels[] = { "Off", "On" };
+static constexpr const char* midiOutLabels[] = { "USB", "Breakout" };
+
+// The whole parameter table is built at compile time and lives in flash:
+// pluginEntry() and construct() only hand out pointers to it.
+
+static constexpr int NAME_LEN = 12;
+
+// "<prefix> <n>" for n up to 999.
+constexpr void writeName(char* out, const char* prefix, int n) {
+    int i = 0;
+    while (prefix[i]) { out[i] = prefix[i]; ++i; }
+    out[i++] = ' ';
+    if (n >= 100) out[i++] = '0' + n / 100;
+    if (n >= 10) out[i++] = '0' + n / 10 % 10;
+    out[i++] = '0' + n % 10;
+    out[i] = 0;
+}
+
+struct SeqNames {
+    char name[MAX_SEQS][SEQ_NUM_PARAMS][NAME_LEN];
+};
+
+constexpr SeqNames makeSeqNames() {
+    SeqNames t{};
+    const char* prefixes[SEQ_NUM_PARAMS] = { "Include", "Steps", "Div", "Range", "Dir", "Gate" };
+    for (int i = 0; i < MAX_SEQS; ++i)
+        for (int f = 0; f < SEQ_NUM_PARAMS; ++f) writeName(t.name[i][f], prefixes[f], i + 1);
+    return t;
+}
+
+static constexpr SeqNames seqNames = makeSeqNames();
+
+// Laid out for the largest instance; construct() copies the prefix it needs
+// and sets the Steps range from the Max Steps specification.
+struct ParamTable {
+    _NT_parameter p[MAX_PARAMS];
+};
+
+constexpr ParamTable makeParams() {
+    ParamTable t{};
+    t.p[IDX_RANDOMIZE] = { "Randomise!", 0, 1, 0, kNT_unitEnum, 0, offOnLabels };
+    t.p[IDX_MIDI_OUT] = { "MIDI Out", 0, 1, 0, kNT_unitEnum, 0, midiOutLabels };
+    t.p[IDX_BPM] = { "BPM", 0, 400, 120, kNT_unitBPM, 0, nullptr };
+    t.p[IDX_CLOCK_BUS] = { "Clock Output", 1, 28, 1, kNT_unitAudioOutput, 0, nullptr };
+    t.p[IDX_SEED] = { "Seed", 0, 32767, 1, kNT_unitNone, 0, nullptr };
+    t.p[IDX_CLOCK_IN] = { "Clock Input", 0, 28, 0, kNT_unitCvInput, 0, nullptr };
+    t.p[IDX_PULSE_TICKS] = { "Ticks/Pulse", 1, 32, 1, kNT_unitNone, 0, nullptr };
+    t.p[IDX_MIDI_CLOCK] = { "MIDI Clock", 0, 1, 0, kNT_unitEnum, 0, offOnLabels };
 
-    for (int i = 0; i < 80; ++i) {
-        paramIndices[i] = i;
+    for (int i = 0; i < MAX_SEQS; ++i) {
+        _NT_parameter* q = &t.p[IDX_SEQ_BASE + i * SEQ_NUM_PARAMS];
+        q[SEQ_INCLUDE] = { seqNames.name[i][SEQ_INCLUDE], 0, 1, 1, kNT_unitEnum, 0, offOnLabels };
+        q[SEQ_STEPS] = { seqNames.name[i][SEQ_STEPS], 1, MAX_STEPS, MAX_STEPS, kNT_unitNone, 0, nullptr };
+        q[SEQ_DIV] = { seqNames.name[i][SEQ_DIV], 1, 32, 1, kNT_unitNone, 0, nullptr };
+        q[SEQ_RANGE] = { seqNames.name[i][SEQ_RANGE], 0, 127, 127, kNT_unitMIDINote, 0, nullptr };
+        q[SEQ_DIR] = { seqNames.name[i][SEQ_DIR], 0, 2, 0, kNT_unitEnum, 0, dirLabels };
+        q[SEQ_GATE] = { seqNames.name[i][SEQ_GATE], 1, 2000, 50, kNT_unitMs, 0, nullptr };
     }
+    return t;
+}
+
+static constexpr ParamTable paramTable = makeParams();
 
-    pages[0] = { "RAND", 17, paramIndices };
-    pages[1] = { "MIDI out", 1, &paramIndices[IDX_MIDI_OUT] };
-    pages[2] = { "CLOCK", 2, &paramIndices[IDX_BPM] };
-    pages[3] = { "PARAM", 60, &paramIndices[IDX_PARAM_BASE] };
+static constexpr uint8_t midiPage[] = { IDX_MIDI_OUT };
+static constexpr uint8_t clockPage[] = { IDX_BPM, IDX_CLOCK_BUS, IDX_CLOCK_IN, IDX_PULSE_TICKS, IDX_MIDI_CLOCK };
+
+static constexpr _NT_specification specifications[] = {
+    { "Sequences", 1, MAX_SEQS, 16, kNT_typeGeneric },
+    { "Max Steps", 1, MAX_STEPS, 16, kNT_typeGeneric },
+};
+
+static int specValue(const int32_t* specs, int i) {
+    const _NT_specification& s = specifications[i];
+    int v = specs ? specs[i] : s.def;
+    return (v < s.min || v > s.max) ? s.def : v;
+}
+
+// SRAM holds Plugin, the instance's parameter table, the note-off deadlines,
+// the MIDI queue, the rest of the note-off queue, the holder counts (past 16
+// sequences only), the RAND and PARAM page index lists and the step data, in
+// that order, so the word-sized arrays stay aligned. DTC holds the lanes.
+struct InstanceLayout {
+    int numSeqs, maxSteps, numParams, midiQueueSize;
+    uint32_t paramsOffset, deadlinesOffset, eventsOffset, noteOffsOffset, heldOffset;
+    uint32_t randPageOffset, seqPageOffset, dataOffset, sramBytes;
+    uint32_t dtcBytes;
+};
+
+static InstanceLayout instanceLayout(const int32_t* specs) {
+    InstanceLayout L;
+    L.numSeqs = specValue(specs, SPEC_SEQS);
+    L.maxSteps = specValue(specs, SPEC_STEPS);
+    L.numParams = IDX_SEQ_BASE + L.numSeqs * SEQ_NUM_PARAMS;
+    L.midiQueueSize = L.numSeqs * MIDI_EVENTS_PER_SEQ;
+    L.paramsOffset = sizeof(Plugin);
+    L.deadlinesOffset = L.paramsOffset + L.numParams * sizeof(_NT_parameter);
+    L.eventsOffset = L.deadlinesOffset + L.numSeqs * sizeof(uint32_t);
+    L.noteOffsOffset = L.eventsOffset + L.midiQueueSize * sizeof(MidiEvent);
+    L.heldOffset = L.noteOffsOffset + L.numSeqs * 4;
+    L.randPageOffset = L.heldOffset + (L.numSeqs > 16 ? 16 * 128 : 0);
+    L.seqPageOffset = L.randPageOffset + L.numSeqs + 2;
+    L.dataOffset = L.seqPageOffset + L.numSeqs * (SEQ_NUM_PARAMS - 1);
+    L.sramBytes = L.dataOffset + L.numSeqs * L.maxSteps;
+    L.dtcBytes = SeqLanes::rowBytes(L.numSeqs);
+    return L;
 }
 
 static void parameterChanged(_NT_algorithm* algo, int p) {
@@ -110,46 +746,111 @@ static void parameterChanged(_NT_algorithm* algo, int p) {
 
     if (p == IDX_RANDOMIZE) {
         self->randomise = algo->v[p];
-    } else if (p >= IDX_INCLUDE_BASE && p < IDX_INCLUDE_BASE + MAX_SEQS) {
-        self->includes[p - IDX_INCLUDE_BASE] = algo->v[p];
-    } else if (p >= IDX_PARAM_BASE) {
-        int seq = (p - IDX_PARAM_BASE) / 4;
-        int field = (p - IDX_PARAM_BASE) % 4;
-        Sequence& s = self->seqs[seq];
-        switch (field) {
-            case 0: s.steps = algo->v[p]; break;
-            case 1: s.div = algo->v[p]; break;
-            case 2: s.range = algo->v[p]; break;
-            case 3: s.dir = static_cast<DirMode>(algo->v[p]); break;
+    } else if (p == IDX_MIDI_OUT) {
+        self->setMidiDest(algo->v[p] == 0 ? kNT_destinationUSB : kNT_destinationBreakout);
+    } else if (p == IDX_SEED) {
+        self->reseed(algo->v[p]);
+    } else if (p == IDX_CLOCK_IN) {
+        self->resetClockIn();
+    } else if (p >= IDX_SEQ_BASE) {
+        int seq = (p - IDX_SEQ_BASE) / SEQ_NUM_PARAMS;
+        SeqLanes& L = self->lanes;
+        switch ((p - IDX_SEQ_BASE) % SEQ_NUM_PARAMS) {
+            case SEQ_INCLUDE: L.include[seq] = algo->v[p]; break;
+            case SEQ_STEPS: L.last[seq] = algo->v[p] - 1; break;
+            case SEQ_DIV: L.div[seq] = algo->v[p]; break;
+            case SEQ_RANGE: L.range[seq] = algo->v[p]; break;
+            case SEQ_DIR: L.dir[seq] = algo->v[p]; break;
+            case SEQ_GATE: L.gate[seq] = algo->v[p]; break;
         }
     }
 }
 
-static void calculateRequirements(_NT_algorithmRequirements& r, const int32_t*) {
-    r.numParameters = 80;
-    r.sram = sizeof(Plugin);
+// May run concurrently with step(): only queue the byte and when it came.
+static void midiRealtime(_NT_algorithm* algo, uint8_t byte) {
+    if (byte == 0xF8 || byte == 0xFA || byte == 0xFB || byte == 0xFC) {
+        static_cast<Plugin*>(algo)->realtime.push(byte, NT_getCpuCycleCount());
+    }
+}
+
+static void calculateRequirements(_NT_algorithmRequirements& r, const int32_t* specs) {
+    InstanceLayout L = instanceLayout(specs);
+    r.numParameters = L.numParams;
+    r.sram = L.sramBytes;
+    r.dram = 0;
+    r.dtc = L.dtcBytes;
+    r.itc = 0;
 }
 
-static _NT_algorithm* construct(const _NT_algorithmMemoryPtrs& ptrs, const _NT_algorithmRequirements&, const int32_t*) {
+static _NT_algorithm* construct(const _NT_algorithmMemoryPtrs& ptrs, const _NT_algorithmRequirements&, const int32_t* specs) {
+    InstanceLayout layout = instanceLayout(specs);
+    int numSeqs = layout.numSeqs;
     Plugin* self = new(ptrs.sram) Plugin;
-    self->parameters = parameters;
-    static _NT_parameterPages allPages = { 4, pages };
-    self->parameterPages = &allPages;
+    self->lanes.carve(ptrs.dtc, ptrs.sram + layout.dataOffset, numSeqs, layout.maxSteps);
+
+    _NT_parameter* params = reinterpret_cast<_NT_parameter*>(ptrs.sram + layout.paramsOffset);
+    for (int i = 0; i < layout.numParams; ++i) params[i] = paramTable.p[i];
+    for (int i = 0; i < numSeqs; ++i) {
+        _NT_parameter& steps = params[IDX_SEQ_BASE + i * SEQ_NUM_PARAMS + SEQ_STEPS];
+        steps.max = layout.maxSteps;
+        steps.def = layout.maxSteps;
+    }
+
+    // RAND: Randomise!, every Include, Seed. PARAM: the rest of each sequence.
+    uint8_t* randPage = ptrs.sram + layout.randPageOffset;
+    uint8_t* seqPage = ptrs.sram + layout.seqPageOffset;
+    randPage[0] = IDX_RANDOMIZE;
+    for (int i = 0; i < numSeqs; ++i) {
+        int base = IDX_SEQ_BASE + i * SEQ_NUM_PARAMS;
+        randPage[1 + i] = base + SEQ_INCLUDE;
+        for (int f = SEQ_STEPS; f < SEQ_NUM_PARAMS; ++f) *seqPage++ = base + f;
+    }
+    randPage[numSeqs + 1] = IDX_SEED;
+    self->pages[0] = { "RAND", (uint8_t)(numSeqs + 2), randPage };
+    self->pages[1] = { "MIDI out", sizeof(midiPage), midiPage };
+    self->pages[2] = { "CLOCK", sizeof(clockPage), clockPage };
+    self->pages[3] = { "PARAM", (uint8_t)(numSeqs * (SEQ_NUM_PARAMS - 1)), ptrs.sram + layout.seqPageOffset };
+    self->pageList = { 4, self->pages };
+
+    self->parameters = params;
+    self->parameterPages = &self->pageList;
     self->v = self->vIncludingCommon + NT_parameterOffset();
-    self->clockCounter = 0;
+    self->tickPhase = 0;
+    self->frameTime = 0;
+    self->gateScale = Plugin::frames16PerMs();
+    self->noteOffs.carve(reinterpret_cast<uint32_t*>(ptrs.sram + layout.deadlinesOffset),
+                         ptrs.sram + layout.noteOffsOffset, numSeqs);
+    self->noteOffs.clear();
+    self->heldCount = nullptr;
+    if (numSeqs > 16) {
+        self->heldCount = ptrs.sram + layout.heldOffset;
+        for (int i = 0; i < 16 * 128; ++i) self->heldCount[i] = 0;
+    }
+    self->midiOut.events = reinterpret_cast<MidiEvent*>(ptrs.sram + layout.eventsOffset);
+    self->midiOut.capacity = layout.midiQueueSize;
+    self->midiOut.count = 0;
+    self->resetClockIn();
+    self->realtime.clear();
+    self->stepCycles = 0;
+    self->stepFrames = 0;
+    self->framesPerCycle = 0.0f;
+    self->midiRunning = false;
+    self->midiClockCount = 0;
+    self->midiDest = kNT_destinationUSB;
     self->randomise = false;
 
-    for (int i = 0; i < MAX_SEQS; ++i) {
-        Sequence& s = self->seqs[i];
-        s.steps = 16;
-        s.div = 1;
-        s.range = 127;
-        s.dir = FWD;
-        s.pos = 0;
-        s.divCounter = 0;
-        for (int j = 0; j < MAX_STEPS; ++j) s.data[j] = rand() % 128;
-        self->includes[i] = true;
+    SeqLanes& L = self->lanes;
+    for (int i = 0; i < numSeqs; ++i) {
+        L.last[i] = layout.maxSteps - 1;
+        L.div[i] = 1;
+        L.range[i] = 127;
+        L.dir[i] = FWD;
+        L.pos[i] = 0;
+        L.divCounter[i] = 0;
+        L.include[i] = true;
+        L.gate[i] = paramTable.p[IDX_SEQ_BASE + SEQ_GATE].def;
     }
+    self->reseed(paramTable.p[IDX_SEED].def);
 
     return self;
 }
@@ -157,22 +858,23 @@ static _NT_algorithm* construct(const _NT_algorithmMemoryPtrs& ptrs, const _NT_a
 static const _NT_factory factory = {
     NT_MULTICHAR('M', 'S', 'Q', 'R'),
     "MIDI Pattern Generator",
-    "Generates 16 random MIDI sequences",
-    0,
-    nullptr,
+    "Generates random MIDI sequences",
+    NUM_SPECS,
+    specifications,
     nullptr,
     nullptr,
     calculateRequirements,
     construct,
     parameterChanged,
     [](auto* self, auto* f, auto n) { static_cast<Plugin*>(self)->step(f, n); },
-    nullptr, nullptr, nullptr,
+    nullptr,
+    midiRealtime,
+    nullptr,
     kNT_tagUtility,
     nullptr, nullptr, nullptr
 };
 
 extern "C" uintptr_t pluginEntry(_NT_selector selector, uint32_t data) {
-    buildParams();
     switch (selector) {
         case kNT_selector_version: return kNT_apiVersionCurrent;
         case kNT_selector_numFactories: return 1;
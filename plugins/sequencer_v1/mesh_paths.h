@@ -0,0 +1,64 @@
+// mesh_paths.h
+//
+// Generated by host/pathopt ("make paths"). Do not edit.
+// Closed drawing paths with the least total blanked travel for each shape.
+
+static const Segment meshPathCube[] = {
+    {0,1,1}, {1,2,1}, {2,3,1}, {3,0,1}, {0,4,1}, {4,5,1}, {5,6,1}, {6,2,1},
+    {2,3,0}, {3,7,1}, {7,6,1}, {6,7,0}, {7,4,1}, {4,5,0}, {5,1,1}, {1,0,0},
+};
+
+static const Segment meshPathTetrahedron[] = {
+    {0,1,1}, {1,2,1}, {2,0,1}, {0,3,1}, {3,2,1}, {2,3,0}, {3,1,1}, {1,0,0},
+};
+
+static const Segment meshPathOctahedron[] = {
+    {0,2,1}, {2,1,1}, {1,3,1}, {3,0,1}, {0,4,1}, {4,1,1}, {1,5,1}, {5,2,1},
+    {2,4,1}, {4,3,1}, {3,5,1}, {5,0,1},
+};
+
+static const Segment meshPathIcosahedron[] = {
+    {0,2,1}, {2,5,1}, {5,3,1}, {3,1,1}, {1,4,1}, {4,0,1}, {0,6,1}, {6,1,1},
+    {1,9,1}, {9,3,1}, {3,7,1}, {7,2,1}, {2,8,1}, {8,0,1}, {0,10,1}, {10,6,1},
+    {6,4,1}, {4,8,1}, {8,5,1}, {5,7,1}, {7,10,1}, {10,11,1}, {11,1,1}, {1,3,0},
+    {3,11,1}, {11,6,1}, {6,4,0}, {4,9,1}, {9,8,1}, {8,9,0}, {9,5,1}, {5,7,0},
+    {7,11,1}, {11,10,0}, {10,2,1}, {2,0,0},
+};
+
+static const Segment meshPathDodecahedron[] = {
+    {0,8,1}, {8,4,1}, {4,14,1}, {14,5,1}, {5,9,1}, {9,1,1}, {1,12,1}, {12,0,1},
+    {0,16,1}, {16,2,1}, {2,10,1}, {10,6,1}, {6,15,1}, {15,7,1}, {7,11,1}, {11,3,1},
+    {3,17,1}, {17,16,1}, {16,17,0}, {17,1,1}, {1,9,0}, {9,11,1}, {11,3,0}, {3,13,1},
+    {13,2,1}, {2,13,0}, {13,15,1}, {15,7,0}, {7,19,1}, {19,18,1}, {18,4,1}, {4,8,0},
+    {8,10,1}, {10,6,0}, {6,18,1}, {18,19,0}, {19,5,1}, {5,14,0}, {14,12,1}, {12,0,0},
+};
+
+static const Segment meshPathTorus[] = {
+    {0,1,1}, {1,2,1}, {2,3,1}, {3,4,1}, {4,5,1}, {5,0,1}, {0,6,1}, {6,7,1},
+    {7,1,1}, {1,67,1}, {67,61,1}, {61,55,1}, {55,49,1}, {49,43,1}, {43,37,1}, {37,31,1},
+    {31,25,1}, {25,19,1}, {19,13,1}, {13,7,1}, {7,8,1}, {8,2,1}, {2,68,1}, {68,62,1},
+    {62,56,1}, {56,50,1}, {50,44,1}, {44,38,1}, {38,32,1}, {32,26,1}, {26,20,1}, {20,14,1},
+    {14,8,1}, {8,9,1}, {9,3,1}, {3,69,1}, {69,63,1}, {63,57,1}, {57,51,1}, {51,45,1},
+    {45,39,1}, {39,33,1}, {33,27,1}, {27,21,1}, {21,15,1}, {15,9,1}, {9,10,1}, {10,4,1},
+    {4,70,1}, {70,64,1}, {64,58,1}, {58,52,1}, {52,46,1}, {46,40,1}, {40,34,1}, {34,28,1},
+    {28,22,1}, {22,16,1}, {16,10,1}, {10,11,1}, {11,5,1}, {5,71,1}, {71,65,1}, {65,59,1},
+    {59,53,1}, {53,47,1}, {47,41,1}, {41,35,1}, {35,29,1}, {29,23,1}, {23,17,1}, {17,11,1},
+    {11,6,1}, {6,12,1}, {12,13,1}, {13,14,1}, {14,15,1}, {15,16,1}, {16,17,1}, {17,12,1},
+    {12,18,1}, {18,19,1}, {19,20,1}, {20,21,1}, {21,22,1}, {22,23,1}, {23,18,1}, {18,24,1},
+    {24,25,1}, {25,26,1}, {26,27,1}, {27,28,1}, {28,29,1}, {29,24,1}, {24,30,1}, {30,31,1},
+    {31,32,1}, {32,33,1}, {33,34,1}, {34,35,1}, {35,30,1}, {30,36,1}, {36,37,1}, {37,38,1},
+    {38,39,1}, {39,40,1}, {40,41,1}, {41,36,1}, {36,42,1}, {42,43,1}, {43,44,1}, {44,45,1},
+    {45,46,1}, {46,47,1}, {47,42,1}, {42,48,1}, {48,49,1}, {49,50,1}, {50,51,1}, {51,52,1},
+    {52,53,1}, {53,48,1}, {48,54,1}, {54,55,1}, {55,56,1}, {56,57,1}, {57,58,1}, {58,59,1},
+    {59,54,1}, {54,60,1}, {60,61,1}, {61,62,1}, {62,63,1}, {63,64,1}, {64,65,1}, {65,60,1},
+    {60,66,1}, {66,67,1}, {67,68,1}, {68,69,1}, {69,70,1}, {70,71,1}, {71,66,1}, {66,0,1},
+};
+
+static const MeshPath meshPaths[kNumShapes] = {
+    { meshPathCube, 8, 12, 16 },
+    { meshPathTetrahedron, 4, 6, 8 },
+    { meshPathOctahedron, 6, 12, 12 },
+    { meshPathIcosahedron, 12, 30, 36 },
+    { meshPathDodecahedron, 20, 30, 40 },
+    { meshPathTorus, 72, 144, 144 },
+};
@@ -1,13 +1,36 @@
 // cube_wireframe_nocull.cpp
 //
-// Disting NT plugin: Draws a rotating wireframe cube on an XY oscilloscope.
-// • The cube is normalised using a single scale factor so all vertices lie on a
-//   unit sphere.
-// • Each edge is traversed in a fixed order with blanked reposition moves so the
-//   geometry is correct with no undesired path jumps.
-// • No hidden‐line culling (all edges are always drawn when the beam is on).
+// Disting NT plugin: Draws a rotating wireframe mesh on an XY oscilloscope.
+// • The Shape specification picks Cube, Tetrahedron, Octahedron, Icosahedron,
+//   Dodecahedron or Torus. Each mesh is normalised using a single scale factor
+//   so its farthest vertex lies on the unit sphere.
+// • Each edge is traversed once along a closed path with blanked reposition
+//   moves so the geometry is correct with no undesired path jumps. The paths
+//   come from mesh_paths.h, generated offline by host/pathopt to minimise
+//   total blanked travel.
+// • Culling Off draws every edge. Blank and Skip hide edges whose two faces
+//   both point away from the camera: Blank keeps the path and darkens them,
+//   Skip drops them and closes the gaps with blanked moves, so the edges left
+//   get the whole period.
+// • The Objects specification draws a scene of 1–4 copies of the mesh, each
+//   with its own rotation, scale and screen position on top of the shared
+//   rotation. One beam visits them in turn along a single combined path, with
+//   a blanked hop from each object to the next.
 // • BlankWindow (0…1000 μs) sets per‐edge blank length; BlankPhase (–1000…+1000 μs) shifts that blank window.
 // • Intensity “on” = +5 V, “off” = 0 V.
+// • CV inputs add to RotX/RotY/RotZ (36° per volt) and Distance (1.00 per
+//   volt) and scale Frequency at 1 V/octave. They are read once per block;
+//   while a rotation CV is patched the vertices are interpolated across the
+//   block from the previous block's, so the spin is smooth with no per-sample
+//   trig.
+// • Spin X/Y/Z turn the mesh continuously about the screen axes at up to
+//   ±360°/s, on top of the rotation parameters. The orientation is a
+//   quaternion advanced by one fixed multiply per block.
+// • Dwell holds the beam still for a number of samples at the start of each
+//   lit edge so a slow scope or galvo can settle into the corner, dark unless
+//   it arrived along a lit edge too; Slew limits the X/Y change per sample.
+//   Both are budgeted in the timing table, so neither adds per-sample work
+//   beyond the slew clamp itself.
 //
 // Pages:
 //   1. Frequency   [1 – 1000 Hz]
@@ -17,6 +40,26 @@
 //   5. Blanking    [BlankWindow (0…1000 μs), BlankPhase (–1000…+1000 μs)]
 //   6. Quantize    [Resolution (0–100)]
 //   7. AmpMod      [AmpMod, AmpCorse, AmpFine, AmpWave, AmpPhase]
+//   8. Traversal   [Traversal (Uniform/Arc length), BlankTime (0–50 %)]
+//   9. Culling     [Culling (Off/Blank/Skip)]
+//  10. CV Inputs   [RotX CV, RotY CV, RotZ CV, Dist CV, Freq CV (0 = none, 1–28)]
+//  11. Spin        [Spin X, Spin Y, Spin Z (±360.0 °/s)]
+//  12. Beam        [Dwell (0 – 32 samples), Slew (0 = off, 1 – 1000 V/ms)]
+//  13+ Object n    [RotX, RotY, RotZ (0 – 360°), Scale (0 – 200 %), X, Y (±100 %)]
+//
+// Uniform traversal gives every segment, blanked or not, an equal slice of the
+// period. Arc length gives visible segments time in proportion to their length
+// and squeezes all blanked reposition moves into BlankTime. In a scene both
+// modes time the combined path. Arc length shares each period between the
+// objects in proportion to their scaled, visible path length and times the
+// hops between them from the vertices they join; Uniform gives each object
+// time by its segment count alone, whatever its Scale. Only Arc length makes
+// room for Slew: in Uniform a blanked move keeps its equal slice, and one the
+// clamp cannot finish in time carries on into the next edge.
+//
+// Build with -DPOLY_PROFILE=1 to bracket step() with NT_getCpuCycleCount() and
+// show min/avg/max cycles per call and per frame on the display. With the
+// default of 0 the counters and the draw() callback are compiled out.
 //
 // All initializer lists exactly match their array dimensions.
 
@@ -26,10 +69,53 @@
 #include <cstring>
 #include <new>
 
+#ifndef POLY_PROFILE
+#define POLY_PROFILE 0
+#endif
+
 static constexpr int faceSizeMax = 6;
 
 //—-----------------------------------------------------------------------------------------------
-// 1) Cube Vertex Data & Drawing Segments
+// 1) Mesh Library
+//
+// The Shape specification picks one of these. initialise() builds every shape's
+// vertices and drawing path into the shared DRAM region once; instances only
+// size their own caches from the chosen shape.
+
+enum {
+    kShapeCube,
+    kShapeTetrahedron,
+    kShapeOctahedron,
+    kShapeIcosahedron,
+    kShapeDodecahedron,
+    kShapeTorus,
+    kNumShapes
+};
+
+static const int kTorusMajor = 12;  // rings around the main axis
+static const int kTorusMinor = 6;   // vertices around each ring
+
+struct ShapeSpec { const char* name; uint8_t numVerts; uint8_t numEdges; uint8_t numFaces; };
+
+static const ShapeSpec shapeSpecs[kNumShapes] = {
+    { "Cube",          8, 12,  6 },
+    { "Tetrahedron",   4,  6,  4 },
+    { "Octahedron",    6, 12,  8 },
+    { "Icosahedron",  12, 30, 20 },
+    { "Dodecahedron", 20, 30, 12 },
+    { "Torus",        kTorusMajor * kTorusMinor, 2 * kTorusMajor * kTorusMinor, kTorusMajor * kTorusMinor },
+};
+
+// A closed path needs at most one blanked move per pair of odd-degree vertices.
+static inline int shapeMaxSegments(int shape) {
+    return shapeSpecs[shape].numEdges + shapeSpecs[shape].numVerts / 2;
+}
+
+// A culled path keeps some edges and may need a blanked move before each one
+// and one more to close the loop.
+static inline int shapeMaxPathSegments(int shape) {
+    return 2 * shapeSpecs[shape].numEdges + 1;
+}
 
 static const float rawCubeVerts[8 * 3] = {
     -1.0f, -1.0f, -1.0f,
@@ -42,16 +128,42 @@ static const float rawCubeVerts[8 * 3] = {
     -1.0f,  1.0f,  1.0f
 };
 
-struct Segment { uint8_t a; uint8_t b; uint8_t draw; };
+// draw is 1 for a lit edge and 0 for a blanked move. Culling on Blank marks
+// hidden edges kSegHidden: dark, but still timed as edges. Vertex indices are
+// 16-bit because a scene's combined path indexes every object's vertices.
+struct Segment { uint16_t a; uint16_t b; uint8_t draw; };
+
+enum { kSegMove = 0, kSegLit = 1, kSegHidden = 2 };
 
-static const Segment cubeSegments[] = {
-    {0,1,1}, {1,2,1}, {2,3,1}, {3,0,1},
-    {0,4,1}, {4,5,1}, {5,6,1}, {6,7,1}, {7,4,1},
-    {4,1,0}, {1,5,1}, {5,2,0}, {2,6,1}, {6,3,0},
-    {3,7,1}, {7,0,0}
+// A precomputed drawing path. numVerts and numEdges record the mesh it was
+// built from, so initialise() can spot a table that no longer matches.
+struct MeshPath {
+    const Segment* segs;
+    uint16_t numVerts;
+    uint16_t numEdges;
+    uint16_t numSegs;
 };
 
-static const int numSegments = sizeof(cubeSegments)/sizeof(cubeSegments[0]);
+// meshPaths[kNumShapes]: minimum blanked-travel paths generated by
+// host/pathopt ("make paths"). Regenerate after changing a shape.
+#include "mesh_paths.h"
+
+// One shape as built by initialise(). Vertices are normalised so the farthest
+// lies on the unit sphere; segment lengths are in the same units. Each face is
+// its outward unit normal and plane offset (n·p for any point p on it), and
+// segFaces gives the two faces either side of each drawn segment.
+struct Mesh {
+    const float (*verts)[3];
+    const Segment* segs;
+    const float*   segLen;
+    const float (*faces)[4];
+    const uint8_t (*segFaces)[2];
+    int   numVerts;
+    int   numSegs;
+    int   numFaces;
+    float visibleLen;   // total length of draw = 1 segments
+    float blankLen;     // total length of draw = 0 segments
+};
 
 // 5) Parameter Definitions
 //—-----------------------------------------------------------------------------------------------
@@ -258,6 +370,180 @@ static const _NT_parameter paramAmpPhase = {
     .enumStrings = NULL
 };
 
+// Traversal parameters ---------------------------------------------------------
+
+static const char* const traversalStrings[] = { "Uniform", "Arc length", NULL };
+static const _NT_parameter paramTraversal = {
+    .name        = "Traversal",
+    .min         = 0,
+    .max         = 1,
+    .def         = 0,
+    .unit        = kNT_unitEnum,
+    .scaling     = kNT_scalingNone,
+    .enumStrings = traversalStrings
+};
+
+static const _NT_parameter paramBlankTime = {
+    .name        = "BlankTime",
+    .min         = 0,
+    .max         = 50,
+    .def         = 10,
+    .unit        = kNT_unitPercent,
+    .scaling     = kNT_scalingNone,
+    .enumStrings = NULL
+};
+
+// Culling parameter -------------------------------------------------------------
+
+enum { kCullOff, kCullBlank, kCullSkip };
+
+static const char* const cullingStrings[] = { "Off", "Blank", "Skip", NULL };
+static const _NT_parameter paramCulling = {
+    .name        = "Culling",
+    .min         = 0,
+    .max         = 2,
+    .def         = 0,
+    .unit        = kNT_unitEnum,
+    .scaling     = kNT_scalingNone,
+    .enumStrings = cullingStrings
+};
+
+// CV input parameters -----------------------------------------------------------
+
+// Input bus for each CV, 0 for none. Rotation is in degrees per volt,
+// Distance in its displayed units per volt; Frequency is 1 V/octave.
+static const float kCvDegPerVolt  = 36.0f;
+static const float kCvDistPerVolt = 1.0f;
+
+static const _NT_parameter paramRotXCv = {
+    .name        = "RotX CV",
+    .min         = 0,
+    .max         = 28,
+    .def         = 0,
+    .unit        = kNT_unitCvInput,
+    .scaling     = kNT_scalingNone,
+    .enumStrings = NULL
+};
+
+static const _NT_parameter paramRotYCv = {
+    .name        = "RotY CV",
+    .min         = 0,
+    .max         = 28,
+    .def         = 0,
+    .unit        = kNT_unitCvInput,
+    .scaling     = kNT_scalingNone,
+    .enumStrings = NULL
+};
+
+static const _NT_parameter paramRotZCv = {
+    .name        = "RotZ CV",
+    .min         = 0,
+    .max         = 28,
+    .def         = 0,
+    .unit        = kNT_unitCvInput,
+    .scaling     = kNT_scalingNone,
+    .enumStrings = NULL
+};
+
+static const _NT_parameter paramDistCv = {
+    .name        = "Dist CV",
+    .min         = 0,
+    .max         = 28,
+    .def         = 0,
+    .unit        = kNT_unitCvInput,
+    .scaling     = kNT_scalingNone,
+    .enumStrings = NULL
+};
+
+static const _NT_parameter paramFreqCv = {
+    .name        = "Freq CV",
+    .min         = 0,
+    .max         = 28,
+    .def         = 0,
+    .unit        = kNT_unitCvInput,
+    .scaling     = kNT_scalingNone,
+    .enumStrings = NULL
+};
+
+// Spin parameters ---------------------------------------------------------------
+
+// Angular velocity about each screen axis, in 0.1 °/s.
+static const _NT_parameter paramSpinX = {
+    .name        = "Spin X",
+    .min         = -3600,
+    .max         = 3600,
+    .def         = 0,
+    .unit        = kNT_unitNone,
+    .scaling     = kNT_scaling10,
+    .enumStrings = NULL
+};
+
+static const _NT_parameter paramSpinY = {
+    .name        = "Spin Y",
+    .min         = -3600,
+    .max         = 3600,
+    .def         = 0,
+    .unit        = kNT_unitNone,
+    .scaling     = kNT_scaling10,
+    .enumStrings = NULL
+};
+
+static const _NT_parameter paramSpinZ = {
+    .name        = "Spin Z",
+    .min         = -3600,
+    .max         = 3600,
+    .def         = 0,
+    .unit        = kNT_unitNone,
+    .scaling     = kNT_scaling10,
+    .enumStrings = NULL
+};
+
+// Beam parameters ---------------------------------------------------------------
+
+static const _NT_parameter paramDwell = {
+    .name        = "Dwell",
+    .min         = 0,
+    .max         = 32,
+    .def         = 0,
+    .unit        = kNT_unitNone,
+    .scaling     = kNT_scalingNone,
+    .enumStrings = NULL
+};
+
+static const _NT_parameter paramSlew = {
+    .name        = "Slew",
+    .min         = 0,    // V/ms, 0 = unlimited
+    .max         = 1000,
+    .def         = 0,
+    .unit        = kNT_unitNone,
+    .scaling     = kNT_scalingNone,
+    .enumStrings = NULL
+};
+
+// Scene object parameters -------------------------------------------------------
+
+// Objects in a scene, set by the Objects specification. Each one appends a
+// block of kObjectParams parameters and an "Object n" page; its rotation is
+// applied before the shared RotX/RotY/RotZ, its X/Y position after, in units
+// of the unit sphere (100 % = 5 V before projection).
+static const int kMaxObjects    = 4;
+static const int kNumBaseParams = 31;
+enum { kObjRotX, kObjRotY, kObjRotZ, kObjScale, kObjPosX, kObjPosY, kObjectParams };
+
+#define OBJECT_PARAMS(n)                                                                        \
+    { .name = "Obj" #n " RotX",  .min = 0,    .max = 360, .def = 0,   .unit = kNT_unitNone,    \
+      .scaling = kNT_scalingNone, .enumStrings = NULL },                                        \
+    { .name = "Obj" #n " RotY",  .min = 0,    .max = 360, .def = 0,   .unit = kNT_unitNone,    \
+      .scaling = kNT_scalingNone, .enumStrings = NULL },                                        \
+    { .name = "Obj" #n " RotZ",  .min = 0,    .max = 360, .def = 0,   .unit = kNT_unitNone,    \
+      .scaling = kNT_scalingNone, .enumStrings = NULL },                                        \
+    { .name = "Obj" #n " Scale", .min = 0,    .max = 200, .def = 100, .unit = kNT_unitPercent, \
+      .scaling = kNT_scalingNone, .enumStrings = NULL },                                        \
+    { .name = "Obj" #n " X",     .min = -100, .max = 100, .def = 0,   .unit = kNT_unitPercent, \
+      .scaling = kNT_scalingNone, .enumStrings = NULL },                                        \
+    { .name = "Obj" #n " Y",     .min = -100, .max = 100, .def = 0,   .unit = kNT_unitPercent, \
+      .scaling = kNT_scalingNone, .enumStrings = NULL }
+
 static const _NT_parameter allParams[] = {
     paramFreq,         //  0
     paramRotX,         //  1
@@ -276,9 +562,31 @@ static const _NT_parameter allParams[] = {
     paramAmpCorse,     // 14
     paramAmpFine,      // 15
     paramAmpWave,      // 16
-    paramAmpPhase      // 17
+    paramAmpPhase,     // 17
+    paramTraversal,    // 18
+    paramBlankTime,    // 19
+    paramCulling,      // 20
+    paramRotXCv,       // 21
+    paramRotYCv,       // 22
+    paramRotZCv,       // 23
+    paramDistCv,       // 24
+    paramFreqCv,       // 25
+    paramSpinX,        // 26
+    paramSpinY,        // 27
+    paramSpinZ,        // 28
+    paramDwell,        // 29
+    paramSlew,         // 30
+    OBJECT_PARAMS(1),  // 31..36
+    OBJECT_PARAMS(2),  // 37..42
+    OBJECT_PARAMS(3),  // 43..48
+    OBJECT_PARAMS(4)   // 49..54
 };
 
+#undef OBJECT_PARAMS
+
+static_assert(sizeof(allParams) / sizeof(allParams[0]) == kNumBaseParams + kMaxObjects * kObjectParams,
+              "one parameter block per scene object");
+
 static const uint8_t page1_indices[] = { 0 };
 static const uint8_t page2_indices[] = { 1, 2, 3 };
 static const uint8_t page3_indices[] = { 4, 5, 6 };
@@ -286,6 +594,15 @@ static const uint8_t page4_indices[] = { 7, 8, 9 };
 static const uint8_t page5_indices[] = { 10, 11 };
 static const uint8_t page6_indices[] = { 12 };
 static const uint8_t page7_indices[] = { 13, 14, 15, 16, 17 };
+static const uint8_t page8_indices[] = { 18, 19 };
+static const uint8_t page9_indices[] = { 20 };
+static const uint8_t page10_indices[] = { 21, 22, 23, 24, 25 };
+static const uint8_t page11_indices[] = { 26, 27, 28 };
+static const uint8_t page12_indices[] = { 29, 30 };
+static const uint8_t page13_indices[] = { 31, 32, 33, 34, 35, 36 };
+static const uint8_t page14_indices[] = { 37, 38, 39, 40, 41, 42 };
+static const uint8_t page15_indices[] = { 43, 44, 45, 46, 47, 48 };
+static const uint8_t page16_indices[] = { 49, 50, 51, 52, 53, 54 };
 
 static const _NT_parameterPage pages[] = {
     { "Frequency",   1,  page1_indices },
@@ -294,25 +611,94 @@ static const _NT_parameterPage pages[] = {
     { "Routing",     3,  page4_indices },
     { "Blanking",    2,  page5_indices },
     { "Quantize",    1,  page6_indices },
-    { "AmpMod",      5,  page7_indices }
+    { "AmpMod",      5,  page7_indices },
+    { "Traversal",   2,  page8_indices },
+    { "Culling",     1,  page9_indices },
+    { "CV Inputs",   5,  page10_indices },
+    { "Spin",        3,  page11_indices },
+    { "Beam",        2,  page12_indices },
+    { "Object 1",    6,  page13_indices },
+    { "Object 2",    6,  page14_indices },
+    { "Object 3",    6,  page15_indices },
+    { "Object 4",    6,  page16_indices }
 };
 
-static const _NT_parameterPages parameterPages = {
-    .numPages = 7,
-    .pages    = pages
+// The object pages come last, so an n-object scene shows the first 12 + n.
+static const _NT_parameterPages parameterPages[kMaxObjects] = {
+    { .numPages = 13, .pages = pages },
+    { .numPages = 14, .pages = pages },
+    { .numPages = 15, .pages = pages },
+    { .numPages = 16, .pages = pages }
 };
 
 //—-----------------------------------------------------------------------------------------------
 // 6) Per‐Instance State Structure
 //—-----------------------------------------------------------------------------------------------
 
+// The drawing phase is a 32-bit fraction of the period, so it wraps exactly
+// and never drifts. kPhaseScale turns a phase difference into a float fraction.
+static const float kPhaseScale = 1.0f / 4294967296.0f;
+
+// Arc-length timing for one segment, in 32-bit phase units. Only segments with
+// a non-zero duration get an entry; [start, last] is inclusive so the final
+// entry can end at 0xFFFFFFFF. invDur converts (phase - start) to 0..1, and
+// blank/shift are BlankWindow/BlankPhase rescaled to this segment's duration.
+// A corner dwell is an entry of its own with invDur = 0, holding the beam on
+// a lit segment's first vertex; blank = 1 keeps it dark (see dwellLit()).
+struct SegTiming {
+    uint32_t start;
+    uint32_t last;
+    float    invDur;
+    float    blank;
+    float    shift;
+    int      seg;       // index into the scene path
+};
+
+// Inter-object hops are timed from the transformed vertices they join, never
+// shorter than kMinHopLen (a tenth of the unit sphere) so two objects at one
+// position still get a blanked move. The table is retimed only once a hop has
+// moved by more than kHopRetime, so a slow spin does not retime every block.
+static const float kMinHopLen = 0.1f;
+static const float kHopRetime = 0.02f;
+
+// One object of the scene. rot is its own RotX/RotY/RotZ; the culled path and
+// face flags are per object because each one turns differently.
+struct SceneObject {
+    float    rot[3][3];
+    float    scale;
+    float    posX, posY;
+    Segment* pathSegs;
+    float*   pathLen;     // length of each path segment, before scaling
+    int      numPathSegs;
+    uint8_t* faceVisible; // per face, as of the last rebuild
+};
+
 struct PolyInstance : public _NT_algorithm {
-    float phase;
+    uint32_t phase;       // drawing phase, wraps at 2^32
     float sinX, cosX;
     float sinY, cosY;
     float sinZ, cosZ;
+    float rot[3][3];      // Rz·Ry·Rx, rebuilt whenever RotX/RotY/RotZ change
+    const Mesh* mesh;     // shape chosen by the Shape specification
+    float (*xverts)[3];   // every object's transformed vertices, refreshed once per block
+    float (*xvertsPrev)[3]; // the previous block's, swapped with xverts each block
+    bool  vertsPrimed;    // xvertsPrev holds a real block
     float freq_Hz;
     float cameraDist;
+    float viewDist;       // cameraDist plus Dist CV, set once per block
+    int   rotCvBus[3];    // RotX/RotY/RotZ CV inputs, 0 = none
+    int   distCvBus, freqCvBus;
+
+    // Auto-rotation: spinQ is the accumulated spin as a unit quaternion
+    // (w, x, y, z), applied after the parameter rotation, about the screen
+    // axes. spinDq is one block's worth of spin, rebuilt only when a rate or
+    // the block size changes; in between each block is a single quaternion
+    // multiply.
+    float    spinRate[3];   // rad/s about X, Y, Z
+    float    spinQ[4];
+    float    spinDq[4];
+    int      spinDqFrames;  // block size spinDq was built for, 0 = stale
+    uint32_t spinBlocks;    // blocks since spinQ was renormalised
     int   projectionMode; // 0=Ortho, 1=Persp
     int   polarity;       // 0=Normal, 1=Inverted
     int   xOutBus, yOutBus, iOutBus;
@@ -321,25 +707,82 @@ struct PolyInstance : public _NT_algorithm {
     float ampModAmt;       // 0..1
     int   ampCorseIdx;     // 0..34
     int   ampFine;         // -100..100 (0.1 Hz units)
-    int   ampWave;         // 0..4
-    float ampPhaseOffset;  // 0..1
-    float ampPhase;        // 0..1 running phase
+    int      ampWave;        // 0..4
+    uint32_t ampPhaseOffset; // 0..360° as a fraction of 2^32
+    uint32_t ampPhase;       // running phase, wraps at 2^32
 
     float blankWindow_us; // 0…1000 μs
     float blankPhase_us;  // –1000…+1000 μs
     int   resolution;     // 0..100
 
-    PolyInstance() {
+    int   traversal;      // 0=Uniform, 1=Arc length
+    float blankTime;      // 0..0.5 of the period shared by blanked moves
+    int   numTimed;       // entries in segTime
+    SegTiming* segTime;   // two entries per scene segment at most, with dwell
+
+    int   dwellSamples;   // held at the start of each edge
+    float slewStep;       // largest X/Y change per sample in volts, 0 = unlimited
+    float beamX, beamY;   // X/Y outputs at the end of the last block, slewed or not
+
+    // Culling: each object's path, rebuilt only when one of its faces turns
+    // toward or away from the camera. Blank keeps the mesh path with hidden
+    // edges marked kSegHidden; Skip keeps only the lit edges.
+    int      cullMode;    // kCullOff, kCullBlank, kCullSkip
+    bool     pathDirty;   // rebuild on the next block regardless
+
+    // Scene: every object's path joined into one closed path, with vertex
+    // indices offset into xverts and lengths scaled. Rebuilt, and retimed,
+    // when a culled path, Scale or position changes; the hops are remeasured
+    // every block.
+    int          numObjects;
+    SceneObject* objects;
+    bool     sceneDirty;
+    Segment* sceneSegs;
+    int      sceneHop[kMaxObjects]; // scene index of the hop leaving each object
+    float*   sceneLen;
+    int      numSceneSegs;
+    float    sceneVisibleLen, sceneBlankLen;
+
+#if POLY_PROFILE
+    // Cycle counters for the current window, published to the display
+    // fields once per window so draw() never sees a half-updated set.
+    uint32_t profCalls;
+    uint32_t profFrames;
+    uint64_t profCycles;
+    uint32_t profMinCall, profMaxCall;
+    float    profMinFrame, profMaxFrame;
+
+    uint32_t dispMinCall, dispAvgCall, dispMaxCall;
+    float    dispMinFrame, dispAvgFrame, dispMaxFrame;
+#endif
+
+    PolyInstance(const Mesh* m, int nObjects, SceneObject* objs, float (*xv)[3],
+                 float (*xvPrev)[3], SegTiming* timing, Segment* scene, float* sceneLength) {
         parameters       = nullptr;
         parameterPages   = nullptr;
         vIncludingCommon = nullptr;
         v                = nullptr;
-        phase            = 0.0f;
+        phase            = 0;
         sinX = 0.0f; cosX = 1.0f;
         sinY = 0.0f; cosY = 1.0f;
         sinZ = 0.0f; cosZ = 1.0f;
+        for (int r = 0; r < 3; ++r)
+            for (int c = 0; c < 3; ++c)
+                rot[r][c] = (r == c) ? 1.0f : 0.0f;
+        mesh             = m;
+        xverts           = xv;
+        xvertsPrev       = xvPrev;
+        vertsPrimed      = false;
         freq_Hz          = 50.0f;
         cameraDist       = 5.0f;
+        viewDist         = 5.0f;
+        rotCvBus[0] = rotCvBus[1] = rotCvBus[2] = 0;
+        distCvBus = freqCvBus = 0;
+        spinRate[0] = spinRate[1] = spinRate[2] = 0.0f;
+        spinQ[0]  = 1.0f; spinQ[1]  = spinQ[2]  = spinQ[3]  = 0.0f;
+        spinDq[0] = 1.0f; spinDq[1] = spinDq[2] = spinDq[3] = 0.0f;
+        spinDqFrames     = 0;
+        spinBlocks       = 0;
         projectionMode   = 1;
         polarity         = 0;
         xOutBus = 12; yOutBus = 13; iOutBus = 14;
@@ -348,10 +791,42 @@ struct PolyInstance : public _NT_algorithm {
         ampCorseIdx      = 4;
         ampFine          = 0;
         ampWave          = 4;
-        ampPhaseOffset   = 0.0f;
-        ampPhase         = 0.0f;
+        ampPhaseOffset   = 0;
+        ampPhase         = 0;
         blankWindow_us   = 10.0f;
         blankPhase_us    = 0.0f;
+        traversal        = 0;
+        blankTime        = 0.1f;
+        dwellSamples     = 0;
+        slewStep         = 0.0f;
+        beamX = beamY    = 0.0f;
+        numTimed         = 1;
+        segTime          = timing;
+        segTime[0].start  = 0;
+        segTime[0].last   = 0xFFFFFFFFu;
+        segTime[0].invDur = kPhaseScale;
+        segTime[0].blank  = 0.0f;
+        segTime[0].shift  = 0.0f;
+        segTime[0].seg    = 0;
+        cullMode         = kCullOff;
+        pathDirty        = true;
+        numObjects       = nObjects;
+        objects          = objs;
+        sceneDirty       = true;
+        sceneSegs        = scene;
+        sceneLen         = sceneLength;
+        sceneSegs[0]     = { 0, 0, 0 };
+        sceneLen[0]      = 0.0f;
+        numSceneSegs     = 1;
+        sceneVisibleLen  = 0.0f;
+        sceneBlankLen    = 0.0f;
+#if POLY_PROFILE
+        profCalls = 0; profFrames = 0; profCycles = 0;
+        profMinCall = UINT32_MAX; profMaxCall = 0;
+        profMinFrame = 1e30f; profMaxFrame = 0.0f;
+        dispMinCall = dispAvgCall = dispMaxCall = 0;
+        dispMinFrame = dispAvgFrame = dispMaxFrame = 0.0f;
+#endif
     }
 };
 
@@ -359,34 +834,484 @@ struct PolyInstance : public _NT_algorithm {
 // 7) Shared DRAM Allocation & Initialization
 //—-----------------------------------------------------------------------------------------------
 
-static const int SHARED_DRAM_BYTES = 256;
+// AmpMod wavetables: one band-limited table per AmpWave entry, each with a
+// guard point so linear interpolation never wraps the index.
+static const int kWaveTableBits   = 9;
+static const int kWaveTableSize   = 1 << kWaveTableBits;
+static const int kWaveTableStride = kWaveTableSize + 1;
+static const int kNumWaves        = 5;
+static const int kWaveHarmonics   = 64;
+static const uint32_t kWaveFracMask  = (1u << (32 - kWaveTableBits)) - 1;
+static const float    kWaveFracScale = 1.0f / static_cast<float>(1u << (32 - kWaveTableBits));
+
+static Mesh   sharedMeshes[kNumShapes];
+static float* sharedWaves = nullptr;
+
+// Shared DRAM is laid out as: all vertices, all segment lengths, all faces,
+// all segments, each segment's face pair, the wavetables, then scratch space
+// that initialise() uses while building paths.
+struct SharedLayout {
+    uint32_t vertsOffset, segLenOffset, facesOffset, segsOffset, segFacesOffset;
+    uint32_t wavesOffset, scratchOffset;
+    uint32_t totalBytes;
+};
+
+// Scratch for building one path: a working edge list plus the Hierholzer stack
+// and output circuit, each sized for the largest shape.
+struct PathScratch {
+    Segment*  edges;      // candidate edges plus blanked moves; draw = 0 marks a move
+    uint8_t*  used;
+    uint16_t* stackV;
+    int16_t*  stackE;
+    uint16_t* circV;
+    int16_t*  circE;
+    uint8_t*  degree;
+};
+
+static inline uint32_t align4(uint32_t n) { return (n + 3u) & ~3u; }
+
+static uint32_t pathScratchBytes(int maxSegs, int maxVerts) {
+    uint32_t n = maxSegs + 1;
+    return align4(maxSegs * sizeof(Segment)) + align4(maxSegs) +
+           4 * align4(n * sizeof(uint16_t)) + align4(maxVerts);
+}
 
+static PathScratch carvePathScratch(uint8_t* p, int maxSegs) {
+    PathScratch s;
+    uint32_t n = maxSegs + 1;
+    s.edges  = reinterpret_cast<Segment*>(p);   p += align4(maxSegs * sizeof(Segment));
+    s.used   = p;                               p += align4(maxSegs);
+    s.stackV = reinterpret_cast<uint16_t*>(p);  p += align4(n * sizeof(uint16_t));
+    s.stackE = reinterpret_cast<int16_t*>(p);   p += align4(n * sizeof(uint16_t));
+    s.circV  = reinterpret_cast<uint16_t*>(p);  p += align4(n * sizeof(uint16_t));
+    s.circE  = reinterpret_cast<int16_t*>(p);   p += align4(n * sizeof(uint16_t));
+    s.degree = p;
+    return s;
+}
 
-static float (*sharedVerts)[3] = nullptr;
+static SharedLayout sharedLayout() {
+    int totalVerts = 0, totalSegs = 0, totalFaces = 0, maxSegs = 0, maxVerts = 0;
+    for (int s = 0; s < kNumShapes; ++s) {
+        int segs = shapeMaxSegments(s);
+        totalVerts += shapeSpecs[s].numVerts;
+        totalSegs  += segs;
+        totalFaces += shapeSpecs[s].numFaces;
+        if (segs > maxSegs) maxSegs = segs;
+        if (shapeSpecs[s].numVerts > maxVerts) maxVerts = shapeSpecs[s].numVerts;
+    }
+    SharedLayout L;
+    L.vertsOffset   = 0;
+    L.segLenOffset  = L.vertsOffset + totalVerts * 3 * sizeof(float);
+    L.facesOffset   = L.segLenOffset + totalSegs * sizeof(float);
+    L.segsOffset    = L.facesOffset + totalFaces * 4 * sizeof(float);
+    L.segFacesOffset = L.segsOffset + align4(totalSegs * sizeof(Segment));
+    L.wavesOffset   = L.segFacesOffset + align4(totalSegs * 2);
+    L.scratchOffset = L.wavesOffset + kNumWaves * kWaveTableStride * sizeof(float);
+    L.totalBytes    = L.scratchOffset + pathScratchBytes(maxSegs, maxVerts);
+    return L;
+}
 
 void calculateStaticRequirements(_NT_staticRequirements& req) {
-    req.dram = SHARED_DRAM_BYTES;
+    req.dram = sharedLayout().totalBytes;
+}
+
+// Fills the five AmpWave tables (Square, Triangle, Saw, Ramp, Sine) by additive
+// synthesis up to kWaveHarmonics, with Lanczos sigma factors to tame the Gibbs
+// overshoot. Harmonics are read back from the sine table by integer index, so
+// this costs kWaveTableSize sinf() calls in total.
+static void buildWavetables(float* waves) {
+    float* square = waves + 0 * kWaveTableStride;
+    float* tri    = waves + 1 * kWaveTableStride;
+    float* saw    = waves + 2 * kWaveTableStride;
+    float* ramp   = waves + 3 * kWaveTableStride;
+    float* sine   = waves + 4 * kWaveTableStride;
+    const float pi = 3.14159265f;
+    const int mask = kWaveTableSize - 1;
+
+    for (int i = 0; i < kWaveTableSize; ++i)
+        sine[i] = sinf(2.0f * pi * static_cast<float>(i) / kWaveTableSize);
+
+    for (int i = 0; i < kWaveTableSize; ++i) {
+        float sq = 0.0f, tr = 0.0f, sw = 0.0f;
+        for (int k = 1; k <= kWaveHarmonics; ++k) {
+            float x = pi * static_cast<float>(k) / (kWaveHarmonics + 1);
+            float sigma = sinf(x) / x;
+            float s = sine[(k * i) & mask];
+            float c = sine[(k * i + kWaveTableSize / 4) & mask];
+            sw += sigma * s / k;
+            if (k & 1) {
+                sq += sigma * s / k;
+                tr += sigma * c / static_cast<float>(k * k);
+            }
+        }
+        square[i] = sq * (4.0f / pi);
+        tri[i]    = tr * (-8.0f / (pi * pi));
+        saw[i]    = sw * (2.0f / pi);
+        ramp[i]   = -saw[i];
+    }
+    for (int w = 0; w < kNumWaves; ++w)
+        waves[w * kWaveTableStride + kWaveTableSize] = waves[w * kWaveTableStride];
+}
+
+// Appends every sign combination of (x, y, z), skipping signs on zero components.
+static int addSignedPoints(float (*out)[3], int n, float x, float y, float z) {
+    for (int sx = 0; sx < (x != 0.0f ? 2 : 1); ++sx)
+        for (int sy = 0; sy < (y != 0.0f ? 2 : 1); ++sy)
+            for (int sz = 0; sz < (z != 0.0f ? 2 : 1); ++sz) {
+                out[n][0] = sx ? -x : x;
+                out[n][1] = sy ? -y : y;
+                out[n][2] = sz ? -z : z;
+                ++n;
+            }
+    return n;
+}
+
+static int buildShapeVerts(int shape, float (*out)[3]) {
+    const float phi    = 1.61803399f;
+    const float invPhi = 0.61803399f;
+    int n = 0;
+    switch (shape) {
+        case kShapeCube:
+            memcpy(out, rawCubeVerts, sizeof(rawCubeVerts));
+            n = 8;
+            break;
+        case kShapeTetrahedron:
+            n = addSignedPoints(out, 0, 1.0f, 1.0f, 1.0f);
+            // Keep the four corners with an even number of negative signs.
+            for (int i = 0, k = 0; i < n; ++i) {
+                int neg = (out[i][0] < 0) + (out[i][1] < 0) + (out[i][2] < 0);
+                if ((neg & 1) == 0) {
+                    out[k][0] = out[i][0]; out[k][1] = out[i][1]; out[k][2] = out[i][2];
+                    ++k;
+                }
+            }
+            n = 4;
+            break;
+        case kShapeOctahedron:
+            n = addSignedPoints(out, n, 1.0f, 0.0f, 0.0f);
+            n = addSignedPoints(out, n, 0.0f, 1.0f, 0.0f);
+            n = addSignedPoints(out, n, 0.0f, 0.0f, 1.0f);
+            break;
+        case kShapeIcosahedron:
+            n = addSignedPoints(out, n, 0.0f, 1.0f, phi);
+            n = addSignedPoints(out, n, 1.0f, phi, 0.0f);
+            n = addSignedPoints(out, n, phi, 0.0f, 1.0f);
+            break;
+        case kShapeDodecahedron:
+            n = addSignedPoints(out, n, 1.0f, 1.0f, 1.0f);
+            n = addSignedPoints(out, n, 0.0f, invPhi, phi);
+            n = addSignedPoints(out, n, invPhi, phi, 0.0f);
+            n = addSignedPoints(out, n, phi, 0.0f, invPhi);
+            break;
+        case kShapeTorus: {
+            const float R = 1.0f, r = 0.4f, twoPi = 6.28318531f;
+            for (int u = 0; u < kTorusMajor; ++u) {
+                float th = twoPi * u / kTorusMajor;
+                for (int v = 0; v < kTorusMinor; ++v) {
+                    float ph = twoPi * v / kTorusMinor;
+                    float ring = R + r * cosf(ph);
+                    out[n][0] = ring * cosf(th);
+                    out[n][1] = ring * sinf(th);
+                    out[n][2] = r * sinf(ph);
+                    ++n;
+                }
+            }
+            break;
+        }
+    }
+    return n;
+}
+
+// Edge list for a shape. The Platonic solids take every vertex pair at the
+// minimum distance; the torus joins grid neighbours along both ring directions.
+static int buildShapeEdges(int shape, const float (*verts)[3], int numVerts, Segment* out) {
+    int n = 0;
+    if (shape == kShapeTorus) {
+        for (int u = 0; u < kTorusMajor; ++u)
+            for (int v = 0; v < kTorusMinor; ++v) {
+                int i = u * kTorusMinor + v;
+                out[n++] = { static_cast<uint16_t>(i), static_cast<uint16_t>(u * kTorusMinor + (v + 1) % kTorusMinor), 1 };
+                out[n++] = { static_cast<uint16_t>(i), static_cast<uint16_t>(((u + 1) % kTorusMajor) * kTorusMinor + v), 1 };
+            }
+        return n;
+    }
+    float minD2 = 1e30f;
+    for (int i = 0; i < numVerts; ++i)
+        for (int j = i + 1; j < numVerts; ++j) {
+            float dx = verts[j][0] - verts[i][0];
+            float dy = verts[j][1] - verts[i][1];
+            float dz = verts[j][2] - verts[i][2];
+            float d2 = dx*dx + dy*dy + dz*dz;
+            if (d2 < minD2) minD2 = d2;
+        }
+    for (int i = 0; i < numVerts; ++i)
+        for (int j = i + 1; j < numVerts; ++j) {
+            float dx = verts[j][0] - verts[i][0];
+            float dy = verts[j][1] - verts[i][1];
+            float dz = verts[j][2] - verts[i][2];
+            float d2 = dx*dx + dy*dy + dz*dz;
+            if (d2 < minD2 * 1.001f)
+                out[n++] = { static_cast<uint16_t>(i), static_cast<uint16_t>(j), 1 };
+        }
+    return n;
+}
+
+static inline float vertDist(const float (*verts)[3], int a, int b) {
+    float dx = verts[b][0] - verts[a][0];
+    float dy = verts[b][1] - verts[a][1];
+    float dz = verts[b][2] - verts[a][2];
+    return sqrtf(dx*dx + dy*dy + dz*dz);
+}
+
+// Make every vertex degree even by joining odd-degree vertices with blanked
+// moves, pairing each with its nearest remaining odd partner. Cheap enough for
+// initialise(); host/pathopt replaces it with an exact minimum-length matching.
+static int pairOddGreedy(const float (*verts)[3], int numVerts,
+                         uint8_t* degree, Segment* edges, int ne) {
+    for (int a = 0; a < numVerts; ++a) {
+        if ((degree[a] & 1) == 0) continue;
+        int best = -1;
+        float bestD = 1e30f;
+        for (int b = a + 1; b < numVerts; ++b) {
+            if ((degree[b] & 1) == 0) continue;
+            float d = vertDist(verts, a, b);
+            if (d < bestD) { bestD = d; best = b; }
+        }
+        if (best < 0) break;
+        edges[ne++] = { static_cast<uint16_t>(a), static_cast<uint16_t>(best), 0 };
+        degree[a]++;
+        degree[best]++;
+    }
+    return ne;
+}
+
+// Hierholzer's algorithm: walk s.edges[0..ne) as a single Eulerian circuit
+// starting at vertex 0. Every degree must be even and the graph connected.
+static int walkEulerCircuit(int ne, PathScratch& s, Segment* out) {
+    memset(s.used, 0, ne);
+    int sp = 0, nc = 0;
+    s.stackV[sp] = 0; s.stackE[sp] = -1; ++sp;
+    while (sp > 0) {
+        int v = s.stackV[sp - 1];
+        int e = 0;
+        while (e < ne && (s.used[e] || (s.edges[e].a != v && s.edges[e].b != v))) ++e;
+        if (e < ne) {
+            s.used[e] = 1;
+            s.stackV[sp] = (s.edges[e].a == v) ? s.edges[e].b : s.edges[e].a;
+            s.stackE[sp] = static_cast<int16_t>(e);
+            ++sp;
+        } else {
+            --sp;
+            s.circV[nc] = s.stackV[sp];
+            s.circE[nc] = s.stackE[sp];
+            ++nc;
+        }
+    }
+
+    // circV is the circuit in reverse; circE[i] is the edge from circV[i+1] to circV[i].
+    int n = 0;
+    for (int i = nc - 1; i > 0; --i) {
+        out[n].a    = static_cast<uint16_t>(s.circV[i]);
+        out[n].b    = static_cast<uint16_t>(s.circV[i - 1]);
+        out[n].draw = s.edges[s.circE[i - 1]].draw;
+        ++n;
+    }
+    return n;
+}
+
+// Turn an edge list into one closed path using the greedy pairing above.
+static int buildEulerPath(const float (*verts)[3], int numVerts,
+                          const Segment* edgeList, int numEdges,
+                          PathScratch& s, Segment* out) {
+    memset(s.degree, 0, numVerts);
+    for (int e = 0; e < numEdges; ++e) {
+        s.edges[e] = edgeList[e];
+        s.degree[edgeList[e].a]++;
+        s.degree[edgeList[e].b]++;
+    }
+    int ne = pairOddGreedy(verts, numVerts, s.degree, s.edges, numEdges);
+    return walkEulerCircuit(ne, s, out);
+}
+
+static void normalize3(float* v);
+
+static inline float dot3(const float* a, const float* b) {
+    return a[0]*b[0] + a[1]*b[1] + a[2]*b[2];
+}
+
+// Index of the face with unit normal n, adding it if it is new.
+static int findOrAddFace(float (*faces)[4], int& numFaces, int maxFaces, const float* n, float h) {
+    for (int f = 0; f < numFaces; ++f)
+        if (dot3(faces[f], n) > 0.9999f) return f;
+    if (numFaces == maxFaces) return 0;
+    faces[numFaces][0] = n[0];
+    faces[numFaces][1] = n[1];
+    faces[numFaces][2] = n[2];
+    faces[numFaces][3] = h;
+    return numFaces++;
+}
+
+// Faces and the two faces beside every drawn segment. For the Platonic solids
+// a face is a plane through an edge and a third vertex with the whole solid
+// behind it; the torus faces are the quads of its grid, pointing away from
+// the tube centre. Blanked segments get 0xFF.
+static int buildShapeFaces(int shape, const float (*verts)[3], int numVerts,
+                           const Segment* segs, int numSegs,
+                           float (*faces)[4], uint8_t (*segFaces)[2]) {
+    const int maxFaces = shapeSpecs[shape].numFaces;
+    int numFaces = 0;
+    if (shape == kShapeTorus) {
+        for (int u = 0; u < kTorusMajor; ++u)
+            for (int v = 0; v < kTorusMinor; ++v) {
+                int u1 = (u + 1) % kTorusMajor, v1 = (v + 1) % kTorusMinor;
+                const float* p00 = verts[u * kTorusMinor + v];
+                const float* p01 = verts[u * kTorusMinor + v1];
+                const float* p10 = verts[u1 * kTorusMinor + v];
+                const float* p11 = verts[u1 * kTorusMinor + v1];
+                float d1[3], d2[3], n[3], c[3] = { 0.0f, 0.0f, 0.0f }, tube[3] = { 0.0f, 0.0f, 0.0f };
+                for (int k = 0; k < 3; ++k) {
+                    d1[k] = p11[k] - p00[k];
+                    d2[k] = p01[k] - p10[k];
+                    c[k]  = 0.25f * (p00[k] + p01[k] + p10[k] + p11[k]);
+                }
+                n[0] = d1[1]*d2[2] - d1[2]*d2[1];
+                n[1] = d1[2]*d2[0] - d1[0]*d2[2];
+                n[2] = d1[0]*d2[1] - d1[1]*d2[0];
+                normalize3(n);
+                // The two rings' vertices average to their tube centres.
+                for (int w = 0; w < kTorusMinor; ++w)
+                    for (int k = 0; k < 3; ++k)
+                        tube[k] += (verts[u * kTorusMinor + w][k] + verts[u1 * kTorusMinor + w][k]) * (0.5f / kTorusMinor);
+                float out[3] = { c[0] - tube[0], c[1] - tube[1], c[2] - tube[2] };
+                if (dot3(n, out) < 0.0f) { n[0] = -n[0]; n[1] = -n[1]; n[2] = -n[2]; }
+                float* f = faces[numFaces++];
+                f[0] = n[0]; f[1] = n[1]; f[2] = n[2]; f[3] = dot3(n, c);
+            }
+        for (int i = 0; i < numSegs; ++i) {
+            segFaces[i][0] = segFaces[i][1] = 0xFF;
+            if (!segs[i].draw) continue;
+            int ua = segs[i].a / kTorusMinor, va = segs[i].a % kTorusMinor;
+            int ub = segs[i].b / kTorusMinor, vb = segs[i].b % kTorusMinor;
+            if (ua == ub) {
+                // Around the tube: the quads of this ring and the one before.
+                int v = ((va + 1) % kTorusMinor == vb) ? va : vb;
+                int u0 = (ua + kTorusMajor - 1) % kTorusMajor;
+                segFaces[i][0] = static_cast<uint8_t>(ua * kTorusMinor + v);
+                segFaces[i][1] = static_cast<uint8_t>(u0 * kTorusMinor + v);
+            } else {
+                // Along the ring: the quads either side of this minor angle.
+                int u = ((ua + 1) % kTorusMajor == ub) ? ua : ub;
+                int v0 = (va + kTorusMinor - 1) % kTorusMinor;
+                segFaces[i][0] = static_cast<uint8_t>(u * kTorusMinor + va);
+                segFaces[i][1] = static_cast<uint8_t>(u * kTorusMinor + v0);
+            }
+        }
+        return numFaces;
+    }
+
+    for (int i = 0; i < numSegs; ++i) {
+        segFaces[i][0] = segFaces[i][1] = 0xFF;
+        if (!segs[i].draw) continue;
+        const float* A = verts[segs[i].a];
+        const float* B = verts[segs[i].b];
+        int found = 0;
+        for (int c = 0; c < numVerts && found < 2; ++c) {
+            if (c == segs[i].a || c == segs[i].b) continue;
+            const float* C = verts[c];
+            float e1[3] = { B[0] - A[0], B[1] - A[1], B[2] - A[2] };
+            float e2[3] = { C[0] - A[0], C[1] - A[1], C[2] - A[2] };
+            float n[3] = { e1[1]*e2[2] - e1[2]*e2[1],
+                           e1[2]*e2[0] - e1[0]*e2[2],
+                           e1[0]*e2[1] - e1[1]*e2[0] };
+            normalize3(n);
+            float h = dot3(n, A);
+            if (h < 0.0f) { n[0] = -n[0]; n[1] = -n[1]; n[2] = -n[2]; h = -h; }
+            bool supporting = h > 1e-4f;
+            for (int k = 0; k < numVerts && supporting; ++k)
+                supporting = dot3(n, verts[k]) <= h + 1e-4f;
+            if (!supporting) continue;
+            int f = findOrAddFace(faces, numFaces, maxFaces, n, h);
+            if (found == 1 && segFaces[i][0] == f) continue;
+            segFaces[i][found++] = static_cast<uint8_t>(f);
+        }
+        if (found == 1) segFaces[i][1] = segFaces[i][0];
+    }
+    return numFaces;
 }
 
 void initialise(_NT_staticMemoryPtrs& ptrs, const _NT_staticRequirements& /*req*/) {
     uint8_t* dram = ptrs.dram;
-    sharedVerts = reinterpret_cast<float(*)[3]>(dram);
-    memcpy(sharedVerts, rawCubeVerts, sizeof(rawCubeVerts));
+    SharedLayout L = sharedLayout();
+    float (*verts)[3] = reinterpret_cast<float(*)[3]>(dram + L.vertsOffset);
+    float*   segLen   = reinterpret_cast<float*>(dram + L.segLenOffset);
+    Segment* segs     = reinterpret_cast<Segment*>(dram + L.segsOffset);
+    float (*faces)[4] = reinterpret_cast<float(*)[4]>(dram + L.facesOffset);
+    uint8_t (*segFaces)[2] = reinterpret_cast<uint8_t(*)[2]>(dram + L.segFacesOffset);
+    sharedWaves = reinterpret_cast<float*>(dram + L.wavesOffset);
+    buildWavetables(sharedWaves);
+
+    int maxSegs = 0;
+    for (int s = 0; s < kNumShapes; ++s)
+        if (shapeMaxSegments(s) > maxSegs) maxSegs = shapeMaxSegments(s);
+    PathScratch scratch = carvePathScratch(dram + L.scratchOffset, maxSegs);
+
+    for (int shape = 0; shape < kNumShapes; ++shape) {
+        Mesh& m = sharedMeshes[shape];
+        int nv = buildShapeVerts(shape, verts);
+
+        float maxL = 0.0f;
+        for (int i = 0; i < nv; ++i) {
+            float x = verts[i][0];
+            float y = verts[i][1];
+            float z = verts[i][2];
+            float len = sqrtf(x*x + y*y + z*z);
+            if (len > maxL) maxL = len;
+        }
+        if (maxL == 0.0f) maxL = 1.0f;
+        float invL = 1.0f / maxL;
+        for (int i = 0; i < nv; ++i) {
+            verts[i][0] *= invL;
+            verts[i][1] *= invL;
+            verts[i][2] *= invL;
+        }
 
-    float maxL = 0.0f;
-    for (int i = 0; i < 8; ++i) {
-        float x = sharedVerts[i][0];
-        float y = sharedVerts[i][1];
-        float z = sharedVerts[i][2];
-        float L = sqrtf(x*x + y*y + z*z);
-        if (L > maxL) maxL = L;
-    }
-    if (maxL == 0.0f) maxL = 1.0f;
-    float invL = 1.0f / maxL;
-    for (int i = 0; i < 8; ++i) {
-        sharedVerts[i][0] *= invL;
-        sharedVerts[i][1] *= invL;
-        sharedVerts[i][2] *= invL;
+        // The segs slot doubles as the edge list: buildEulerPath copies it
+        // into scratch before writing the path back over it.
+        int ne = buildShapeEdges(shape, verts, nv, segs);
+        int ns;
+        const MeshPath& path = meshPaths[shape];
+        if (path.numVerts == nv && path.numEdges == ne && path.numSegs <= shapeMaxSegments(shape)) {
+            ns = path.numSegs;
+            memcpy(segs, path.segs, ns * sizeof(Segment));
+        } else {
+            ns = buildEulerPath(verts, nv, segs, ne, scratch, segs);
+        }
+
+        // Segment lengths are rotation invariant, so arc-length timing only
+        // needs them once. Instances rescale them into per-segment time slices.
+        m.visibleLen = 0.0f;
+        m.blankLen   = 0.0f;
+        for (int i = 0; i < ns; ++i) {
+            float len = vertDist(verts, segs[i].a, segs[i].b);
+            segLen[i] = len;
+            if (segs[i].draw) m.visibleLen += len;
+            else              m.blankLen   += len;
+        }
+
+        m.numFaces = buildShapeFaces(shape, verts, nv, segs, ns, faces, segFaces);
+        m.verts    = verts;
+        m.segs     = segs;
+        m.segLen   = segLen;
+        m.faces    = faces;
+        m.segFaces = segFaces;
+        m.numVerts = nv;
+        m.numSegs  = ns;
+
+        verts    += shapeSpecs[shape].numVerts;
+        segs     += shapeMaxSegments(shape);
+        segLen   += shapeMaxSegments(shape);
+        faces    += shapeSpecs[shape].numFaces;
+        segFaces += shapeMaxSegments(shape);
     }
 }
 
@@ -394,9 +1319,52 @@ void initialise(_NT_staticMemoryPtrs& ptrs, const _NT_staticRequirements& /*req*
 // 8) Per-Instance Memory Requirements
 //—-----------------------------------------------------------------------------------------------
 
-void calculateRequirements(_NT_algorithmRequirements& req, const int32_t* /*specs*/) {
-    req.numParameters = sizeof(allParams) / sizeof(allParams[0]);
-    req.sram = 4096;
+static inline int specShape(const int32_t* specs) {
+    int shape = specs ? specs[0] : kShapeCube;
+    return (shape < 0 || shape >= kNumShapes) ? kShapeCube : shape;
+}
+
+static inline int specObjects(const int32_t* specs) {
+    int n = specs ? specs[1] : 1;
+    return (n < 1) ? 1 : (n > kMaxObjects) ? kMaxObjects : n;
+}
+
+// Each object's path plus, when there is more than one, a hop to the next.
+static inline int sceneMaxSegments(int shape, int numObjects) {
+    return numObjects * shapeMaxPathSegments(shape) + (numObjects > 1 ? numObjects : 0);
+}
+
+// PolyInstance is followed in SRAM by the scene objects, the transformed
+// vertex caches for this block and the last, the arc-length timing table,
+// the scene path's lengths, the objects' culled path lengths, the scene
+// path, the culled paths, and the per-face visibility flags, all sized for
+// the chosen shape and object count.
+struct InstanceLayout {
+    uint32_t objectsOffset, xvertsOffset, xvertsPrevOffset, segTimeOffset, sceneLenOffset, pathLenOffset;
+    uint32_t sceneSegsOffset, pathSegsOffset, faceVisOffset;
+    uint32_t totalBytes;
+};
+
+static InstanceLayout instanceLayout(int shape, int numObjects) {
+    int maxPath  = shapeMaxPathSegments(shape);
+    int maxScene = sceneMaxSegments(shape, numObjects);
+    InstanceLayout L;
+    L.objectsOffset   = sizeof(PolyInstance);
+    L.xvertsOffset    = L.objectsOffset + numObjects * sizeof(SceneObject);
+    L.xvertsPrevOffset = L.xvertsOffset + numObjects * shapeSpecs[shape].numVerts * 3 * sizeof(float);
+    L.segTimeOffset   = L.xvertsPrevOffset + numObjects * shapeSpecs[shape].numVerts * 3 * sizeof(float);
+    L.sceneLenOffset  = L.segTimeOffset + 2 * maxScene * sizeof(SegTiming);
+    L.pathLenOffset   = L.sceneLenOffset + maxScene * sizeof(float);
+    L.sceneSegsOffset = L.pathLenOffset + numObjects * maxPath * sizeof(float);
+    L.pathSegsOffset  = L.sceneSegsOffset + maxScene * sizeof(Segment);
+    L.faceVisOffset   = L.pathSegsOffset + numObjects * maxPath * sizeof(Segment);
+    L.totalBytes      = L.faceVisOffset + numObjects * shapeSpecs[shape].numFaces;
+    return L;
+}
+
+void calculateRequirements(_NT_algorithmRequirements& req, const int32_t* specs) {
+    req.numParameters = kNumBaseParams + specObjects(specs) * kObjectParams;
+    req.sram = instanceLayout(specShape(specs), specObjects(specs)).totalBytes;
     req.dram = 0;
     req.dtc  = 0;
     req.itc  = 0;
@@ -415,20 +1383,352 @@ static void normalize3(float* v) {
     }
 }
 
-static inline float oscWave(int type, float phase) {
-    phase -= floorf(phase);
-    switch (type) {
-        case 0: // Square
-            return (phase < 0.5f) ? 1.0f : -1.0f;
-        case 1: // Triangle
-            return (phase < 0.5f) ? (4.0f*phase-1.0f) : (3.0f-4.0f*phase);
-        case 2: // Saw
-            return 1.0f - 2.0f*phase;
-        case 3: // Ramp
-            return 2.0f*phase - 1.0f;
-        case 4: // Sine
-        default:
-            return sinf(2.0f * 3.14159265f * phase);
+// Linear-interpolated wavetable read. The top kWaveTableBits of the phase pick
+// the entry and the rest is the fraction, so wrapping is free.
+static inline float waveLookup(const float* table, uint32_t phase) {
+    uint32_t idx  = phase >> (32 - kWaveTableBits);
+    float    frac = static_cast<float>(phase & kWaveFracMask) * kWaveFracScale;
+    float    a    = table[idx];
+    return a + frac * (table[idx + 1] - a);
+}
+
+// Combine the three Euler rotations (X, then Y, then Z) into one matrix so
+// step() applies 9 multiplies per vertex instead of three chained rotations.
+static void eulerMatrix(float sx, float cx, float sy, float cy, float sz, float cz,
+                        float m[3][3]) {
+    m[0][0] = cz * cy;
+    m[0][1] = cz * sy * sx - sz * cx;
+    m[0][2] = cz * sy * cx + sz * sx;
+    m[1][0] = sz * cy;
+    m[1][1] = sz * sy * sx + cz * cx;
+    m[1][2] = sz * sy * cx - cz * sx;
+    m[2][0] = -sy;
+    m[2][1] = cy * sx;
+    m[2][2] = cy * cx;
+}
+
+static void updateRotation(PolyInstance* inst) {
+    eulerMatrix(inst->sinX, inst->cosX, inst->sinY, inst->cosY, inst->sinZ, inst->cosZ, inst->rot);
+}
+
+// Rotation matrix of a unit quaternion (w, x, y, z). The identity quaternion
+// gives the identity matrix exactly.
+static void quatMatrix(const float q[4], float m[3][3]) {
+    const float w = q[0], x = q[1], y = q[2], z = q[3];
+    m[0][0] = 1.0f - 2.0f * (y * y + z * z);
+    m[0][1] = 2.0f * (x * y - w * z);
+    m[0][2] = 2.0f * (x * z + w * y);
+    m[1][0] = 2.0f * (x * y + w * z);
+    m[1][1] = 1.0f - 2.0f * (x * x + z * z);
+    m[1][2] = 2.0f * (y * z - w * x);
+    m[2][0] = 2.0f * (x * z - w * y);
+    m[2][1] = 2.0f * (y * z + w * x);
+    m[2][2] = 1.0f - 2.0f * (x * x + y * y);
+}
+
+// Advance the spin by one block of numFrames. The per-block quaternion is
+// exact (one sinf/cosf pair) but only rebuilt when a rate or the block size
+// changes, so steady spin costs a quaternion multiply and no trig. Rounding
+// still walks |q| away from 1, so every kSpinRenormBlocks blocks one Newton
+// step pulls it back, which needs no sqrt.
+static const uint32_t kSpinRenormBlocks = 64;
+
+static void advanceSpin(PolyInstance* inst, int numFrames) {
+    if (inst->spinDqFrames != numFrames) {
+        const float dt = static_cast<float>(numFrames) / static_cast<float>(NT_globals.sampleRate);
+        const float* w = inst->spinRate;
+        float rate = sqrtf(w[0] * w[0] + w[1] * w[1] + w[2] * w[2]);
+        float half = 0.5f * rate * dt;
+        float k = (rate > 0.0f) ? sinf(half) / rate : 0.0f;
+        inst->spinDq[0] = cosf(half);
+        inst->spinDq[1] = w[0] * k;
+        inst->spinDq[2] = w[1] * k;
+        inst->spinDq[3] = w[2] * k;
+        inst->spinDqFrames = numFrames;
+    }
+    // Axes are fixed to the screen, so the block's turn goes on the left.
+    const float* d = inst->spinDq;
+    float* q = inst->spinQ;
+    float qw = d[0] * q[0] - d[1] * q[1] - d[2] * q[2] - d[3] * q[3];
+    float qx = d[0] * q[1] + d[1] * q[0] + d[2] * q[3] - d[3] * q[2];
+    float qy = d[0] * q[2] - d[1] * q[3] + d[2] * q[0] + d[3] * q[1];
+    float qz = d[0] * q[3] + d[1] * q[2] - d[2] * q[1] + d[3] * q[0];
+    if (++inst->spinBlocks >= kSpinRenormBlocks) {
+        float g = 0.5f * (3.0f - (qw * qw + qx * qx + qy * qy + qz * qz));
+        qw *= g; qx *= g; qy *= g; qz *= g;
+        inst->spinBlocks = 0;
+    }
+    q[0] = qw; q[1] = qx; q[2] = qy; q[3] = qz;
+}
+
+// A corner dwell only holds lit segment i. The beam stays lit through it only
+// if it arrived along a lit edge; after a blanked move or a hidden edge it
+// settles in the dark. Both traversals use this.
+static inline bool dwellLit(const Segment* segs, int i, int numSegs) {
+    return segs[(i > 0) ? i - 1 : numSegs - 1].draw == kSegLit;
+}
+
+// Rebuild the arc-length timing table: visible segments share (1 - BlankTime)
+// of the period by length, blanked moves share BlankTime by length. The blank
+// window is a fixed time at the 50 Hz reference (as in Uniform mode) and is
+// rescaled to each segment's own duration.
+// The table follows the scene path, so with Culling on Skip it follows the
+// culled edges and in a scene it shares the period across the objects.
+//
+// Dwell and Slew are budgeted here in samples at the Frequency parameter
+// (Freq CV scales them with everything else). Each lit edge gets a dwell
+// entry, the dwells together taking at most half the period. Blanked moves
+// all travel at one speed, so if Slew would stop them arriving in time their
+// share is raised, up to half the period, until it does. Edges are left to
+// Frequency: a lower setting gives them more samples.
+static void updateTraversal(PolyInstance* inst) {
+    const float freqRef = 50.0f;
+    const Segment* segs    = inst->sceneSegs;
+    const float* segLen    = inst->sceneLen;
+    const int numSegs      = inst->numSceneSegs;
+    const float visibleLen = inst->sceneVisibleLen;
+    const float blankLen   = inst->sceneBlankLen;
+    const float periodSamples = static_cast<float>(NT_globals.sampleRate) / inst->freq_Hz;
+
+    float dwell = 0.0f;
+    int numEdges = 0;
+    if (inst->dwellSamples > 0) {
+        for (int i = 0; i < numSegs; ++i) numEdges += segs[i].draw == kSegLit;
+        dwell = static_cast<float>(inst->dwellSamples) / periodSamples;
+        if (dwell * numEdges > 0.5f) dwell = 0.5f / numEdges;
+    }
+    float blankBudget = (blankLen > 0.0f) ? inst->blankTime : 0.0f;
+    if (inst->slewStep > 0.0f && blankLen > 0.0f) {
+        float need = 5.0f * blankLen / inst->slewStep / periodSamples;
+        if (need > blankBudget) blankBudget = (need > 0.5f) ? 0.5f : need;
+    }
+    float visScale    = (visibleLen > 0.0f) ? (1.0f - dwell * numEdges - blankBudget) / visibleLen : 0.0f;
+    float blankScale  = (blankLen > 0.0f) ? blankBudget / blankLen : 0.0f;
+    float windowPhase = inst->blankWindow_us * 1e-6f * freqRef;
+    float shiftPhase  = inst->blankPhase_us * 1e-6f * freqRef;
+
+    float t = 0.0f;
+    int n = 0;
+    for (int i = 0; i < numSegs; ++i) {
+        if (dwell > 0.0f && segs[i].draw == kSegLit) {
+            uint32_t start = static_cast<uint32_t>(static_cast<int64_t>(t * 4294967296.0f));
+            t += dwell;
+            uint32_t end = static_cast<uint32_t>(static_cast<int64_t>(t * 4294967296.0f));
+            if (end != start) {
+                SegTiming& st = inst->segTime[n++];
+                st.start  = start;
+                st.last   = end - 1;
+                st.invDur = 0.0f;
+                st.blank  = dwellLit(segs, i, numSegs) ? 0.0f : 1.0f;
+                st.shift  = 0.0f;
+                st.seg    = i;
+            }
+        }
+        float dur = segLen[i] * (segs[i].draw ? visScale : blankScale);
+        uint32_t start = static_cast<uint32_t>(static_cast<int64_t>(t * 4294967296.0f));
+        t += dur;
+        uint32_t end = static_cast<uint32_t>(static_cast<int64_t>(t * 4294967296.0f));
+        if (end == start) continue;   // zero-length: the cursor never stops here
+        SegTiming& st = inst->segTime[n++];
+        st.start  = start;
+        st.last   = end - 1;
+        st.invDur = 1.0f / static_cast<float>(end - start);
+        float blank = windowPhase / dur;
+        float shift = shiftPhase / dur;
+        st.blank  = (blank > 0.5f) ? 0.5f : blank;
+        st.shift  = (shift > 0.999f) ? 0.999f : (shift < -0.999f) ? -0.999f : shift;
+        st.seg    = i;
+    }
+    if (n == 0) {
+        // Degenerate mesh: park on the first segment.
+        inst->segTime[0].start  = 0;
+        inst->segTime[0].invDur = kPhaseScale;
+        inst->segTime[0].blank  = 0.0f;
+        inst->segTime[0].shift  = 0.0f;
+        inst->segTime[0].seg    = 0;
+        n = 1;
+    }
+    // Absorb rounding so the table covers the whole period.
+    inst->segTime[n - 1].last = 0xFFFFFFFFu;
+    inst->numTimed = n;
+}
+
+// Rebuild one object's culled path from its faceVisible; an edge stays lit
+// while either face beside it is visible. Blank copies the mesh path with
+// unlit edges marked kSegHidden. Skip keeps only the lit edges in mesh path
+// order, taking each in whichever direction continues from the beam, and
+// bridges the gaps with blanked moves.
+static void rebuildCulledPath(PolyInstance* inst, SceneObject& obj) {
+    const Mesh* m = inst->mesh;
+    const uint8_t* vis = obj.faceVisible;
+    Segment* out = obj.pathSegs;
+    float* len = obj.pathLen;
+    int n = 0;
+
+    if (inst->cullMode == kCullBlank) {
+        for (int i = 0; i < m->numSegs; ++i) {
+            Segment sg = m->segs[i];
+            if (sg.draw && !(vis[m->segFaces[i][0]] | vis[m->segFaces[i][1]])) sg.draw = kSegHidden;
+            out[n] = sg;
+            len[n] = m->segLen[i];
+            ++n;
+        }
+        obj.numPathSegs = n;
+        return;
+    }
+
+    int first = -1, at = -1;
+    for (int i = 0; i < m->numSegs; ++i) {
+        Segment sg = m->segs[i];
+        if (!sg.draw || !(vis[m->segFaces[i][0]] | vis[m->segFaces[i][1]])) continue;
+        if (sg.b == at) { sg.b = sg.a; sg.a = static_cast<uint16_t>(at); }
+        if (at < 0) {
+            first = sg.a;
+        } else if (sg.a != at) {
+            out[n] = { static_cast<uint16_t>(at), sg.a, kSegMove };
+            len[n++] = vertDist(m->verts, at, sg.a);
+        }
+        out[n] = sg;
+        len[n++] = m->segLen[i];
+        at = sg.b;
+    }
+    if (n == 0) {
+        // Everything culled: park the dark beam on one vertex.
+        out[n] = { m->segs[0].a, m->segs[0].a, kSegMove };
+        len[n++] = 0.0f;
+    } else if (at != first) {
+        out[n] = { static_cast<uint16_t>(at), static_cast<uint16_t>(first), kSegMove };
+        len[n++] = vertDist(m->verts, at, first);
+    }
+    obj.numPathSegs = n;
+}
+
+// Back-face test for every face of one object, once per block. R is the
+// object's full rotation. In perspective a face is visible when the camera at
+// z = -cameraDist is in front of its plane, which Scale and the X/Y position
+// move; orthographic, and the inverted projection (which has no real camera),
+// view along +z, where only the normal's z matters. The path is rebuilt only
+// when some face has turned. Returns true if it was.
+static bool updateCulling(PolyInstance* inst, SceneObject& obj, const float R[3][3]) {
+    const Mesh* m = inst->mesh;
+    const bool persp = inst->projectionMode == 1 && inst->polarity == 0;
+    const float hScale = persp ? 1.0f : 0.0f;
+    const float d      = persp ? inst->viewDist : 1.0f;
+    bool changed = inst->pathDirty;
+    for (int f = 0; f < m->numFaces; ++f) {
+        const float* n = m->faces[f];
+        float nx = R[0][0] * n[0] + R[0][1] * n[1] + R[0][2] * n[2];
+        float ny = R[1][0] * n[0] + R[1][1] * n[1] + R[1][2] * n[2];
+        float nz = R[2][0] * n[0] + R[2][1] * n[1] + R[2][2] * n[2];
+        float h  = obj.scale * n[3] + nx * obj.posX + ny * obj.posY;
+        uint8_t visible = (hScale * h + d * nz) < 0.0f;
+        changed |= visible != obj.faceVisible[f];
+        obj.faceVisible[f] = visible;
+    }
+    if (!changed) return false;
+    rebuildCulledPath(inst, obj);
+    return true;
+}
+
+// Join every object's path into the scene path. Each object's path is closed,
+// so the beam leaves an object where it entered; a blanked hop then takes it
+// to the next object's start. Hops start at kMinHopLen until measureHops()
+// times them from the vertices; the caller retimes.
+static void rebuildScene(PolyInstance* inst) {
+    const Mesh* m = inst->mesh;
+    const bool culled    = inst->cullMode != kCullOff;
+    const int numObjects = inst->numObjects;
+    Segment* out = inst->sceneSegs;
+    float* len = inst->sceneLen;
+    float visibleLen = 0.0f, blankLen = 0.0f;
+    int n = 0;
+    for (int k = 0; k < numObjects; ++k) {
+        const SceneObject& obj = inst->objects[k];
+        const Segment* segs = culled ? obj.pathSegs : m->segs;
+        const float* segLen = culled ? obj.pathLen : m->segLen;
+        const int numSegs   = culled ? obj.numPathSegs : m->numSegs;
+        const int base      = k * m->numVerts;
+        for (int i = 0; i < numSegs; ++i) {
+            Segment sg = segs[i];
+            sg.a = static_cast<uint16_t>(sg.a + base);
+            sg.b = static_cast<uint16_t>(sg.b + base);
+            out[n] = sg;
+            len[n] = segLen[i] * obj.scale;
+            if (sg.draw) visibleLen += len[n];
+            else         blankLen   += len[n];
+            ++n;
+        }
+        if (numObjects > 1) {
+            const int j = (k + 1 < numObjects) ? k + 1 : 0;
+            const SceneObject& next = inst->objects[j];
+            const Segment* nextSegs = culled ? next.pathSegs : m->segs;
+            out[n] = { out[n - 1].b, static_cast<uint16_t>(nextSegs[0].a + j * m->numVerts), kSegMove };
+            len[n] = kMinHopLen;
+            inst->sceneHop[k] = n;
+            blankLen += len[n++];
+        }
+    }
+    inst->numSceneSegs    = n;
+    inst->sceneVisibleLen = visibleLen;
+    inst->sceneBlankLen   = blankLen;
+    inst->sceneDirty      = false;
+}
+
+// Time every hop from the endpoints this block draws, out[n-1].b to the next
+// object's first vertex, so it follows rotation and Scale as well as
+// position. All the hops are replaced once any has moved by more than
+// kHopRetime, or always after a rebuild. Returns true if they were.
+static bool measureHops(PolyInstance* inst, bool force) {
+    const float (*xv)[3] = inst->xverts;
+    float hop[kMaxObjects];
+    bool changed = force;
+    for (int k = 0; k < inst->numObjects; ++k) {
+        const Segment& sg = inst->sceneSegs[inst->sceneHop[k]];
+        float dx = xv[sg.b][0] - xv[sg.a][0];
+        float dy = xv[sg.b][1] - xv[sg.a][1];
+        float dz = xv[sg.b][2] - xv[sg.a][2];
+        float d  = sqrtf(dx * dx + dy * dy + dz * dz);
+        hop[k] = (d < kMinHopLen) ? kMinHopLen : d;
+        changed |= fabsf(hop[k] - inst->sceneLen[inst->sceneHop[k]]) > kHopRetime;
+    }
+    if (!changed) return false;
+    for (int k = 0; k < inst->numObjects; ++k) {
+        float& len = inst->sceneLen[inst->sceneHop[k]];
+        inst->sceneBlankLen += hop[k] - len;
+        len = hop[k];
+    }
+    return true;
+}
+
+// Scene object parameters. Rotation rebuilds the object's matrix; Scale and
+// position change the scene's lengths, so the scene is rebuilt next block.
+static void objectParameterChanged(PolyInstance* inst, int p) {
+    const int k    = (p - kNumBaseParams) / kObjectParams;
+    const int base = kNumBaseParams + k * kObjectParams;
+    SceneObject& obj = inst->objects[k];
+    switch (p - base) {
+        case kObjRotX:
+        case kObjRotY:
+        case kObjRotZ: {
+            const float toRad = 3.14159265f / 180.0f;
+            float rx = inst->v[base + kObjRotX] * toRad;
+            float ry = inst->v[base + kObjRotY] * toRad;
+            float rz = inst->v[base + kObjRotZ] * toRad;
+            eulerMatrix(sinf(rx), cosf(rx), sinf(ry), cosf(ry), sinf(rz), cosf(rz), obj.rot);
+            break;
+        }
+        case kObjScale:
+            obj.scale = static_cast<float>(inst->v[p]) / 100.0f;
+            inst->sceneDirty = true;
+            break;
+        case kObjPosX:
+            obj.posX = static_cast<float>(inst->v[p]) / 100.0f;
+            inst->sceneDirty = true;
+            break;
+        case kObjPosY:
+            obj.posY = static_cast<float>(inst->v[p]) / 100.0f;
+            inst->sceneDirty = true;
+            break;
     }
 }
 
@@ -451,6 +1751,7 @@ void parameterChanged(_NT_algorithm* baseSelf, int p) {
         case 0: // Frequency
             raw = inst->v[0];
             inst->freq_Hz = static_cast<float>(raw);
+            updateTraversal(inst);   // Dwell and Slew are budgeted in samples
             break;
         case 1: // RotX
             raw = inst->v[1];
@@ -459,6 +1760,7 @@ void parameterChanged(_NT_algorithm* baseSelf, int p) {
                 inst->sinX = sinf(r);
                 inst->cosX = cosf(r);
             }
+            updateRotation(inst);
             break;
         case 2: // RotY
             raw = inst->v[2];
@@ -467,6 +1769,7 @@ void parameterChanged(_NT_algorithm* baseSelf, int p) {
                 inst->sinY = sinf(r);
                 inst->cosY = cosf(r);
             }
+            updateRotation(inst);
             break;
         case 3: // RotZ
             raw = inst->v[3];
@@ -475,6 +1778,7 @@ void parameterChanged(_NT_algorithm* baseSelf, int p) {
                 inst->sinZ = sinf(r);
                 inst->cosZ = cosf(r);
             }
+            updateRotation(inst);
             break;
         case 4: // Distance
             raw = inst->v[4];
@@ -507,10 +1811,12 @@ void parameterChanged(_NT_algorithm* baseSelf, int p) {
         case 10: // BlankWindow
             raw = inst->v[10];
             inst->blankWindow_us = static_cast<float>(raw);
+            updateTraversal(inst);
             break;
         case 11: // BlankPhase
             raw = inst->v[11];
             inst->blankPhase_us = static_cast<float>(raw);
+            updateTraversal(inst);
             break;
         case 12: // Resolution
             raw = inst->v[12];
@@ -534,9 +1840,52 @@ void parameterChanged(_NT_algorithm* baseSelf, int p) {
             break;
         case 17: // AmpPhase
             raw = inst->v[17];
-            inst->ampPhaseOffset = static_cast<float>(raw) / 360.0f;
+            inst->ampPhaseOffset = static_cast<uint32_t>((static_cast<uint64_t>(raw) << 32) / 360);
+            break;
+        case 18: // Traversal
+            raw = inst->v[18];
+            inst->traversal = (raw != 0 ? 1 : 0);
+            break;
+        case 19: // BlankTime
+            raw = inst->v[19];
+            inst->blankTime = static_cast<float>(raw) * 0.01f;
+            updateTraversal(inst);
+            break;
+        case 20: // Culling
+            raw = inst->v[20];
+            inst->cullMode   = raw;
+            inst->pathDirty  = true;
+            inst->sceneDirty = true;
+            break;
+        case 21: // RotX CV
+        case 22: // RotY CV
+        case 23: // RotZ CV
+            inst->rotCvBus[p - 21] = inst->v[p];
+            break;
+        case 24: // Dist CV
+            inst->distCvBus = inst->v[24];
+            break;
+        case 25: // Freq CV
+            inst->freqCvBus = inst->v[25];
+            break;
+        case 26: // Spin X
+        case 27: // Spin Y
+        case 28: // Spin Z
+            inst->spinRate[p - 26] = inst->v[p] * (0.1f * 3.14159265f / 180.0f);
+            inst->spinDqFrames = 0;
+            break;
+        case 29: // Dwell
+            inst->dwellSamples = inst->v[29];
+            updateTraversal(inst);
+            break;
+        case 30: // Slew
+            raw = inst->v[30];
+            inst->slewStep = static_cast<float>(raw) * 1000.0f / static_cast<float>(NT_globals.sampleRate);
+            updateTraversal(inst);
             break;
         default:
+            if (p >= kNumBaseParams && p < kNumBaseParams + inst->numObjects * kObjectParams)
+                objectParameterChanged(inst, p);
             break;
     }
 }
@@ -547,33 +1896,404 @@ void parameterChanged(_NT_algorithm* baseSelf, int p) {
 
 _NT_algorithm* constructAlgorithm(const _NT_algorithmMemoryPtrs& ptrs,
                                   const _NT_algorithmRequirements& /*req*/,
-                                  const int32_t* /*specs*/) {
-    void* sramBase = ptrs.sram;
-    PolyInstance* inst = new (sramBase) PolyInstance();
+                                  const int32_t* specs) {
+    int shape      = specShape(specs);
+    int numObjects = specObjects(specs);
+    int maxPath    = shapeMaxPathSegments(shape);
+    uint8_t* sram = ptrs.sram;
+    InstanceLayout L = instanceLayout(shape, numObjects);
+    SceneObject* objects = reinterpret_cast<SceneObject*>(sram + L.objectsOffset);
+    float (*xverts)[3]   = reinterpret_cast<float(*)[3]>(sram + L.xvertsOffset);
+    float (*xvertsPrev)[3] = reinterpret_cast<float(*)[3]>(sram + L.xvertsPrevOffset);
+    SegTiming* segTime   = reinterpret_cast<SegTiming*>(sram + L.segTimeOffset);
+    float*   sceneLen    = reinterpret_cast<float*>(sram + L.sceneLenOffset);
+    float*   pathLen     = reinterpret_cast<float*>(sram + L.pathLenOffset);
+    Segment* sceneSegs   = reinterpret_cast<Segment*>(sram + L.sceneSegsOffset);
+    Segment* pathSegs    = reinterpret_cast<Segment*>(sram + L.pathSegsOffset);
+    for (int k = 0; k < numObjects; ++k) {
+        SceneObject& obj = objects[k];
+        for (int r = 0; r < 3; ++r)
+            for (int c = 0; c < 3; ++c)
+                obj.rot[r][c] = (r == c) ? 1.0f : 0.0f;
+        obj.scale       = 1.0f;
+        obj.posX        = 0.0f;
+        obj.posY        = 0.0f;
+        obj.pathSegs    = pathSegs + k * maxPath;
+        obj.pathLen     = pathLen + k * maxPath;
+        obj.pathSegs[0] = { 0, 0, kSegMove };
+        obj.pathLen[0]  = 0.0f;
+        obj.numPathSegs = 1;
+        obj.faceVisible = sram + L.faceVisOffset + k * shapeSpecs[shape].numFaces;
+    }
+    PolyInstance* inst = new (sram) PolyInstance(&sharedMeshes[shape], numObjects, objects,
+                                                 xverts, xvertsPrev, segTime, sceneSegs, sceneLen);
     inst->parameters       = allParams;
-    inst->parameterPages   = &parameterPages;
+    inst->parameterPages   = &parameterPages[numObjects - 1];
+    rebuildScene(inst);
+    updateTraversal(inst);
     return reinterpret_cast<_NT_algorithm*>(inst);
 }
 
 //—-----------------------------------------------------------------------------------------------
-// 12) Audio‐Rate step: Draw Eulerian cycle (no culling)
+// 12) Audio‐Rate step: Draw Eulerian cycle
 //—-----------------------------------------------------------------------------------------------
 
+// Everything the per-sample loop reads, copied out of PolyInstance once per
+// block. Holding it in a local struct tells the compiler none of it can alias
+// busFrames, so nothing is reloaded after each store.
+struct RenderState {
+    const float (*xverts)[3];
+    const float (*xvertsPrev)[3];
+    float  interpStep;    // 1 / numFrames: the weight of xvertsPrev drops by this per sample
+    const Segment* segs;
+    int    numSegs;
+    const SegTiming* segTime;
+    int    segCursor;
+    float* busX;
+    float* busY;
+    float* busI;
+    uint32_t phase, phaseInc;
+    const float* ampTable;
+    uint32_t ampPhase, ampPhaseInc, ampPhaseOffset;
+    float  ampModAmt;
+    float  blankFrac, blankFracHi, shiftFrac;
+    float  dwellFrac, dwellScale;  // Uniform only: hold lit edges for dwellFrac, then cover them
+    float  cameraDist;
+    float  scaleQ;
+};
+
+enum { kProjOrtho, kProjPersp, kProjPerspInverted };
+
+typedef void (*RenderFn)(RenderState& st, int numFrames);
+
+// One specialisation per projection/polarity, quantise on/off, AmpMod on/off,
+// traversal mode and vertex interpolation, so the loop body carries no
+// parameter branches. With AmpMod == 0 ampMul is exactly 1 and the wavetable
+// read is skipped. Interp blends each endpoint from the previous block's
+// vertices to this block's, reaching them exactly on the last sample.
+template <int Proj, bool Quantize, bool AmpMod, bool ArcLength, bool Interp>
+static void renderBlock(RenderState& st, int numFrames) {
+    const float (*xverts)[3] = st.xverts;
+    const float (*xvertsPrev)[3] = st.xvertsPrev;
+    const float interpStep   = st.interpStep;
+    const SegTiming* segTime = st.segTime;
+    float* const busX = st.busX;
+    float* const busY = st.busY;
+    float* const busI = st.busI;
+    const uint32_t phaseInc = st.phaseInc;
+    const float* ampTable   = st.ampTable;
+    const uint32_t ampPhaseInc = st.ampPhaseInc;
+    const uint32_t ampOffset   = st.ampPhaseOffset;
+    const float ampModAmt   = st.ampModAmt;
+    const float blankFrac   = st.blankFrac;
+    const float blankFracHi = st.blankFracHi;
+    const float shiftFrac   = st.shiftFrac;
+    const float dwellFrac   = st.dwellFrac;
+    const float dwellScale  = st.dwellScale;
+    const float cameraDist  = st.cameraDist;
+    const float scaleQ      = st.scaleQ;
+    const Segment* segs     = st.segs;
+    const int   eLen        = st.numSegs;
+
+    uint32_t phase = st.phase;
+    int   cur      = st.segCursor;
+    uint32_t ampPhase = st.ampPhase;
+    for (int i = 0; i < numFrames; ++i) {
+        uint32_t prev = phase;
+        phase += phaseInc;          // wraps modulo 2^32
+        if (ArcLength && phase < prev) cur = 0;
+
+        // Amplitude modulation oscillator
+        ampPhase += ampPhaseInc;
+        float ampMul = 1.0f;
+        if (AmpMod)
+            ampMul = 1.0f + ampModAmt * waveLookup(ampTable, ampPhase + ampOffset);
+
+        // frac times the blank window; along places the beam on the segment,
+        // and differs from frac only while a Uniform dwell holds it.
+        int   idx;
+        float frac, along, segBlank, segBlankHi, segShift;
+        if (ArcLength) {
+            // Phase only moves forward within a period, so the segment cursor
+            // advances at most a step or two per sample.
+            while (phase > segTime[cur].last) ++cur;
+            const SegTiming& tm = segTime[cur];
+            idx        = tm.seg;
+            frac       = static_cast<float>(phase - tm.start) * tm.invDur;
+            along      = frac;
+            segBlank   = tm.blank;
+            segBlankHi = 1.0f - segBlank;
+            segShift   = tm.shift;
+        } else {
+            // phase * eLen as a 32.32 product: the high word is the segment,
+            // the low word the position along it. No float wrap or clamp.
+            uint64_t ePos = static_cast<uint64_t>(phase) * static_cast<uint32_t>(eLen);
+            idx        = static_cast<int>(ePos >> 32);
+            frac       = static_cast<float>(static_cast<uint32_t>(ePos)) * kPhaseScale;
+            along      = frac;
+            segBlank   = blankFrac;
+            segBlankHi = blankFracHi;
+            segShift   = shiftFrac;
+            if (dwellFrac > 0.0f && segs[idx].draw == kSegLit) {
+                if (frac > dwellFrac) {
+                    along = (frac - dwellFrac) * dwellScale;
+                } else {
+                    // Held on the first vertex, lit as an arc-length dwell entry
+                    along      = 0.0f;
+                    segBlank   = dwellLit(segs, idx, eLen) ? 0.0f : 1.0f;
+                    segBlankHi = 1.0f - segBlank;
+                    segShift   = 0.0f;
+                }
+            }
+        }
+
+        float fShift = frac + segShift;
+        if (fShift <  0.0f) fShift += 1.0f;
+        if (fShift >= 1.0f) fShift -= 1.0f;
+
+        const Segment& sg = segs[idx];
+
+        // Interpolate the rotated endpoints:
+        const float* A = xverts[sg.a];
+        const float* B = xverts[sg.b];
+        float Ax = A[0], Ay = A[1], Az = A[2];
+        float Bx = B[0], By = B[1], Bz = B[2];
+        if (Interp) {
+            const float* A0 = xvertsPrev[sg.a];
+            const float* B0 = xvertsPrev[sg.b];
+            const float u = static_cast<float>(numFrames - 1 - i) * interpStep;
+            Ax += u * (A0[0] - Ax); Ay += u * (A0[1] - Ay); Az += u * (A0[2] - Az);
+            Bx += u * (B0[0] - Bx); By += u * (B0[1] - By); Bz += u * (B0[2] - Bz);
+        }
+        float Xr = Ax + along * (Bx - Ax);
+        float Yr = Ay + along * (By - Ay);
+        float Zr = Az + along * (Bz - Az);
+
+        if (Quantize) {
+            Xr = roundf((Xr + 1.0f) * scaleQ) / scaleQ - 1.0f;
+            Yr = roundf((Yr + 1.0f) * scaleQ) / scaleQ - 1.0f;
+            Zr = roundf((Zr + 1.0f) * scaleQ) / scaleQ - 1.0f;
+        }
+
+        // Project:
+        float Xv, Yv;
+        if (Proj == kProjPersp) {
+            float dcam = Zr + cameraDist;
+            if (dcam == 0.0f) dcam = 0.0001f;
+            float scale = cameraDist / dcam;
+            Xv = 5.0f * (Xr * scale);
+            Yv = 5.0f * (Yr * scale);
+        } else if (Proj == kProjPerspInverted) {
+            float dcam = Zr + cameraDist;
+            float scale = dcam / cameraDist;
+            Xv = 5.0f * (Xr * scale);
+            Yv = 5.0f * (Yr * scale);
+        } else {
+            Xv = 5.0f * Xr;
+            Yv = 5.0f * Yr;
+        }
+
+        // Only kSegLit turns the beam on; culled edges arrive as kSegHidden
+        const bool lit = sg.draw == kSegLit;
+        float Iout = (lit ? 5.0f : 0.0f);
+        if (lit && ((fShift < segBlank) || (fShift > segBlankHi))) {
+            Iout = 0.0f;
+        }
+
+        busX[i] = Xv * ampMul;
+        busY[i] = Yv * ampMul;
+        busI[i] = Iout;
+    }
+    st.phase     = phase;
+    st.segCursor = cur;
+    st.ampPhase  = ampPhase;
+}
+
+template <int Proj, bool Quantize, bool AmpMod, bool ArcLength>
+static RenderFn selectInterp(bool interp) {
+    return interp ? renderBlock<Proj, Quantize, AmpMod, ArcLength, true>
+                  : renderBlock<Proj, Quantize, AmpMod, ArcLength, false>;
+}
+
+template <int Proj, bool Quantize, bool AmpMod>
+static RenderFn selectTraversal(bool arcLength, bool interp) {
+    return arcLength ? selectInterp<Proj, Quantize, AmpMod, true>(interp)
+                     : selectInterp<Proj, Quantize, AmpMod, false>(interp);
+}
+
+template <int Proj, bool Quantize>
+static RenderFn selectAmpMod(bool ampMod, bool arcLength, bool interp) {
+    return ampMod ? selectTraversal<Proj, Quantize, true>(arcLength, interp)
+                  : selectTraversal<Proj, Quantize, false>(arcLength, interp);
+}
+
+template <int Proj>
+static RenderFn selectQuantize(bool quantize, bool ampMod, bool arcLength, bool interp) {
+    return quantize ? selectAmpMod<Proj, true>(ampMod, arcLength, interp)
+                    : selectAmpMod<Proj, false>(ampMod, arcLength, interp);
+}
+
+static RenderFn selectRender(const PolyInstance* inst, bool interp) {
+    bool quantize  = inst->resolution > 0;
+    bool ampMod    = inst->ampModAmt != 0.0f;
+    bool arcLength = inst->traversal != 0;
+    if (inst->projectionMode != 1)
+        return selectQuantize<kProjOrtho>(quantize, ampMod, arcLength, interp);
+    if (inst->polarity == 0)
+        return selectQuantize<kProjPersp>(quantize, ampMod, arcLength, interp);
+    return selectQuantize<kProjPerspInverted>(quantize, ampMod, arcLength, interp);
+}
+
+// Clamp each X/Y step to at most step volts, carrying the beam across blocks.
+// Only Arc length gives blanked moves the time this needs (updateTraversal()).
+// A separate pass over the finished block, so the renderer specialisations
+// are unchanged and the cost is the same for every sample.
+static void slewLimit(float* busX, float* busY, int numFrames, float step, float& beamX, float& beamY) {
+    float x = beamX, y = beamY;
+    for (int i = 0; i < numFrames; ++i) {
+        float dx = busX[i] - x;
+        float dy = busY[i] - y;
+        dx = (dx > step) ? step : (dx < -step) ? -step : dx;
+        dy = (dy > step) ? step : (dy < -step) ? -step : dy;
+        x += dx;
+        y += dy;
+        busX[i] = x;
+        busY[i] = y;
+    }
+    beamX = x;
+    beamY = y;
+}
+
+// A CV input's value for this block: its last sample. bus is 1-based.
+static inline float cvInput(const float* busFrames, int bus, int numFrames) {
+    return busFrames[bus * numFrames - 1];
+}
+
+// Binary search for the timing entry containing phase. Done once per block so
+// the cursor stays valid after the table is rebuilt by parameterChanged().
+static int locateSegment(const SegTiming* segTime, int numTimed, uint32_t phase) {
+    int lo = 0, hi = numTimed - 1;
+    while (lo < hi) {
+        int mid = (lo + hi + 1) >> 1;
+        if (segTime[mid].start <= phase) lo = mid;
+        else                             hi = mid - 1;
+    }
+    return lo;
+}
+
+#if POLY_PROFILE
+static void profileRecord(PolyInstance* inst, uint32_t cycles, int numFrames);
+#endif
+
 void step(_NT_algorithm* baseSelf, float* busFrames, int numFramesBy4) {
     PolyInstance* inst = reinterpret_cast<PolyInstance*>(baseSelf);
+#if POLY_PROFILE
+    uint32_t profStart = NT_getCpuCycleCount();
+#endif
 
     int   numFrames = numFramesBy4 * 4;
     float fs        = static_cast<float>(NT_globals.sampleRate);
     float freq      = inst->freq_Hz;
-    int   eLen      = numSegments;
+    const Mesh* mesh = inst->mesh;
+
+    // CV modulation, once per block. Rotation CVs need their own trig; with
+    // none patched the matrix parameterChanged() built is used as is.
+    // Rotation that moves between blocks, by CV or by spin, is interpolated.
+    if (inst->freqCvBus) {
+        freq *= exp2f(cvInput(busFrames, inst->freqCvBus, numFrames));
+        if (freq > 0.5f * fs) freq = 0.5f * fs;
+    }
+    inst->viewDist = inst->cameraDist;
+    if (inst->distCvBus) {
+        float d = inst->cameraDist + kCvDistPerVolt * cvInput(busFrames, inst->distCvBus, numFrames);
+        inst->viewDist = (d < 0.111f) ? 0.111f : d;
+    }
+    const bool rotCv = (inst->rotCvBus[0] | inst->rotCvBus[1] | inst->rotCvBus[2]) != 0;
+    float rot[3][3];
+    if (rotCv) {
+        float sc[3][2];
+        for (int a = 0; a < 3; ++a) {
+            float deg = static_cast<float>(inst->v[1 + a]);
+            if (inst->rotCvBus[a])
+                deg += kCvDegPerVolt * cvInput(busFrames, inst->rotCvBus[a], numFrames);
+            float r = deg * (3.14159265f / 180.0f);
+            sc[a][0] = sinf(r);
+            sc[a][1] = cosf(r);
+        }
+        eulerMatrix(sc[0][0], sc[0][1], sc[1][0], sc[1][1], sc[2][0], sc[2][1], rot);
+    } else {
+        memcpy(rot, inst->rot, sizeof(rot));
+    }
+
+    // Auto-rotation is applied after the parameter rotation (S·rot), so it
+    // turns the mesh about the fixed screen axes. A stopped spin keeps its
+    // last orientation; before any spin the product is exact.
+    const bool spinning = (inst->spinRate[0] != 0.0f) | (inst->spinRate[1] != 0.0f) |
+                          (inst->spinRate[2] != 0.0f);
+    if (spinning) advanceSpin(inst, numFrames);
+    {
+        float S[3][3], SR[3][3];
+        quatMatrix(inst->spinQ, S);
+        for (int r = 0; r < 3; ++r)
+            for (int c = 0; c < 3; ++c)
+                SR[r][c] = S[r][0] * rot[0][c] + S[r][1] * rot[1][c] + S[r][2] * rot[2][c];
+        memcpy(rot, SR, sizeof(rot));
+    }
+
+    // This block's vertices go in the buffer two blocks old; the last block's
+    // stay behind as the start point for interpolation.
+    float (*swap)[3] = inst->xvertsPrev;
+    inst->xvertsPrev = inst->xverts;
+    inst->xverts     = swap;
+
+    // Transform every object's vertices once per block: its own rotation, the
+    // shared rotation, Scale, then its X/Y position. The transform is affine,
+    // so lerping the transformed endpoints per sample lands on the same point
+    // as transforming the lerp. Culling then picks each object's path, and
+    // the scene is rebuilt before anything is timed from it.
+    const float (*verts)[3] = mesh->verts;
+    const bool culled = inst->cullMode != kCullOff;
+    bool sceneChanged = inst->sceneDirty;
+    for (int k = 0; k < inst->numObjects; ++k) {
+        SceneObject& obj = inst->objects[k];
+        float R[3][3];
+        for (int r = 0; r < 3; ++r)
+            for (int c = 0; c < 3; ++c)
+                R[r][c] = rot[r][0] * obj.rot[0][c] + rot[r][1] * obj.rot[1][c] +
+                          rot[r][2] * obj.rot[2][c];
+        const float s  = obj.scale;
+        const float m00 = R[0][0] * s, m01 = R[0][1] * s, m02 = R[0][2] * s;
+        const float m10 = R[1][0] * s, m11 = R[1][1] * s, m12 = R[1][2] * s;
+        const float m20 = R[2][0] * s, m21 = R[2][1] * s, m22 = R[2][2] * s;
+        const float tx = obj.posX, ty = obj.posY;
+        float (*xverts)[3] = inst->xverts + k * mesh->numVerts;
+        for (int v = 0; v < mesh->numVerts; ++v) {
+            float Px = verts[v][0];
+            float Py = verts[v][1];
+            float Pz = verts[v][2];
+            xverts[v][0] = m00 * Px + m01 * Py + m02 * Pz + tx;
+            xverts[v][1] = m10 * Px + m11 * Py + m12 * Pz + ty;
+            xverts[v][2] = m20 * Px + m21 * Py + m22 * Pz;
+        }
+        if (culled && updateCulling(inst, obj, R)) sceneChanged = true;
+    }
+    if (culled) inst->pathDirty = false;
+    if (sceneChanged) rebuildScene(inst);
+    if (inst->numObjects > 1 && measureHops(inst, sceneChanged)) sceneChanged = true;
+    if (sceneChanged) updateTraversal(inst);
+    if (!inst->vertsPrimed) {
+        memcpy(inst->xvertsPrev, inst->xverts, inst->numObjects * mesh->numVerts * sizeof(inst->xverts[0]));
+        inst->vertsPrimed = true;
+    }
+    const Segment* segs = inst->sceneSegs;
+    int   eLen          = inst->numSceneSegs;
+
+    RenderState st;
 
     // Get output buses:
-    int busXidx = inst->xOutBus;
-    int busYidx = inst->yOutBus;
-    int busIidx = inst->iOutBus;
-    float* busX = busFrames + busXidx * numFrames;
-    float* busY = busFrames + busYidx * numFrames;
-    float* busI = busFrames + busIidx * numFrames;
+    st.busX = busFrames + inst->xOutBus * numFrames;
+    st.busY = busFrames + inst->yOutBus * numFrames;
+    st.busI = busFrames + inst->iOutBus * numFrames;
 
     // Compute blank fractions:
     // Use a fixed reference frequency so blanking covers the same path length
@@ -582,125 +2302,140 @@ void step(_NT_algorithm* baseSelf, float* busFrames, int numFramesBy4) {
     const float freqRef = 50.0f;  // reference = default Frequency parameter
     float blankFrac = inst->blankWindow_us * 1e-6f * freqRef * static_cast<float>(eLen);
     if (blankFrac > 0.5f) blankFrac = 0.5f;
-    float shiftFrac = inst->blankPhase_us * 1e-6f * freqRef * static_cast<float>(eLen);
+    st.blankFrac   = blankFrac;
+    st.blankFracHi = 1.0f - blankFrac;
+    st.shiftFrac   = inst->blankPhase_us * 1e-6f * freqRef * static_cast<float>(eLen);
+
+    // Uniform dwell: the same share of every lit segment, from this block's rate.
+    float dwellFrac = static_cast<float>(inst->dwellSamples) * freq * static_cast<float>(eLen) / fs;
+    if (dwellFrac > 0.5f) dwellFrac = 0.5f;
+    st.dwellFrac  = dwellFrac;
+    st.dwellScale = 1.0f / (1.0f - dwellFrac);
 
     float ampCourseFac = getCourseFactor(inst->ampCorseIdx);
     float ampFreqBase  = freq * ampCourseFac;
     float ampFreq      = ampFreqBase + (static_cast<float>(inst->ampFine) * 0.1f);
     if (ampFreq < 0.0f) ampFreq = 0.0f;
-    float ampPhase     = inst->ampPhase;
-
-    float phase = inst->phase;
-    for (int i = 0; i < numFrames; ++i) {
-        
-
-        phase += (freq / fs);
-        if (phase >= 1.0f) phase -= 1.0f;
-
-        // Amplitude modulation oscillator
-        ampPhase += (ampFreq / fs);
-        if (ampPhase >= 1.0f) ampPhase -= floorf(ampPhase);
-        float ampVal = oscWave(inst->ampWave, ampPhase + inst->ampPhaseOffset);
-        float ampMul = 1.0f + inst->ampModAmt * ampVal;
-
-        float ePos = phase * static_cast<float>(eLen);
-        int   idx  = static_cast<int>(floorf(ePos));
-        if (idx >= eLen) idx = eLen - 1;
-        float frac = ePos - static_cast<float>(idx);
+    int wave = inst->ampWave;
+    if (wave < 0 || wave >= kNumWaves) wave = kNumWaves - 1;
+    st.ampTable       = sharedWaves + wave * kWaveTableStride;
+    st.ampPhase       = inst->ampPhase;
+    // float -> int64 -> uint32 wraps rates above fs instead of overflowing.
+    st.ampPhaseInc    = static_cast<uint32_t>(static_cast<int64_t>((ampFreq / fs) * 4294967296.0f));
+    st.ampPhaseOffset = inst->ampPhaseOffset;
+    st.ampModAmt      = inst->ampModAmt;
+
+    st.phase      = inst->phase;
+    // Computed in double once per block; the fixed-point step then accumulates
+    // with no rounding at all, so the period stays exact over long runs.
+    st.phaseInc   = static_cast<uint32_t>(static_cast<int64_t>(static_cast<double>(freq) / fs * 4294967296.0));
+    st.cameraDist = inst->viewDist;
+    st.scaleQ     = static_cast<float>(inst->resolution) * 0.5f;
+    st.xverts     = inst->xverts;
+    st.xvertsPrev = inst->xvertsPrev;
+    st.interpStep = 1.0f / static_cast<float>(numFrames);
+    st.segs      = segs;
+    st.numSegs   = eLen;
+    st.segTime   = inst->segTime;
+    st.segCursor = locateSegment(inst->segTime, inst->numTimed, st.phase);
+
+    selectRender(inst, rotCv || spinning)(st, numFrames);
+    if (inst->slewStep > 0.0f) {
+        slewLimit(st.busX, st.busY, numFrames, inst->slewStep, inst->beamX, inst->beamY);
+    } else {
+        // Follow the beam while Slew is off, so turning it on slews from
+        // where the beam is rather than where it was when Slew was last on.
+        inst->beamX = st.busX[numFrames - 1];
+        inst->beamY = st.busY[numFrames - 1];
+    }
 
-        float fShift = frac + shiftFrac;
-        if (fShift <  0.0f) fShift += 1.0f;
-        if (fShift >= 1.0f) fShift -= 1.0f;
+    inst->phase     = st.phase;
+    inst->ampPhase  = st.ampPhase;
+#if POLY_PROFILE
+    profileRecord(inst, NT_getCpuCycleCount() - profStart, numFrames);
+#endif
+}
 
-        const Segment& seg = cubeSegments[idx];
-        uint8_t vA = seg.a;
-        uint8_t vB = seg.b;
-
-        // Interpolate endpoints:
-        float Ax = sharedVerts[vA][0];
-        float Ay = sharedVerts[vA][1];
-        float Az = sharedVerts[vA][2];
-        float Bx = sharedVerts[vB][0];
-        float By = sharedVerts[vB][1];
-        float Bz = sharedVerts[vB][2];
-        float Px = (1.0f - frac)*Ax + frac*Bx;
-        float Py = (1.0f - frac)*Ay + frac*By;
-        float Pz = (1.0f - frac)*Az + frac*Bz;
-
-        // Rotate around X:
-        float Y1 = inst->cosX * Py - inst->sinX * Pz;
-        float Z1 = inst->sinX * Py + inst->cosX * Pz;
-        float X1 = Px;
-        // Rotate around Y:
-        float X2 = inst->cosY * X1 + inst->sinY * Z1;
-        float Z2 = -inst->sinY * X1 + inst->cosY * Z1;
-        float Y2 = Y1;
-        // Rotate around Z:
-        float Xr = inst->cosZ * X2 - inst->sinZ * Y2;
-        float Yr = inst->sinZ * X2 + inst->cosZ * Y2;
-        float Zr = Z2;
-
-        if (inst->resolution > 0) {
-            float res = static_cast<float>(inst->resolution);
-            float scaleQ = res * 0.5f;
-            Xr = roundf((Xr + 1.0f) * scaleQ) / scaleQ - 1.0f;
-            Yr = roundf((Yr + 1.0f) * scaleQ) / scaleQ - 1.0f;
-            Zr = roundf((Zr + 1.0f) * scaleQ) / scaleQ - 1.0f;
-        }
+//—-----------------------------------------------------------------------------------------------
+// 13) Profiling (POLY_PROFILE only)
+//—-----------------------------------------------------------------------------------------------
 
-        // Project:
-        float Xv, Yv;
-        if (inst->projectionMode == 1) {
-            if (inst->polarity == 0) {
-                float dcam = Zr + inst->cameraDist;
-                if (dcam == 0.0f) dcam = 0.0001f;
-                float scale = inst->cameraDist / dcam;
-                Xv = 5.0f * (Xr * scale);
-                Yv = 5.0f * (Yr * scale);
-            } else {
-                float dcam = Zr + inst->cameraDist;
-                float scale = dcam / inst->cameraDist;
-                Xv = 5.0f * (Xr * scale);
-                Yv = 5.0f * (Yr * scale);
-            }
-        } else {
-            Xv = 5.0f * Xr;
-            Yv = 5.0f * Yr;
-        }
+#if POLY_PROFILE
+
+static void profileRecord(PolyInstance* inst, uint32_t cycles, int numFrames) {
+    float perFrame = static_cast<float>(cycles) / static_cast<float>(numFrames);
+    if (cycles < inst->profMinCall) inst->profMinCall = cycles;
+    if (cycles > inst->profMaxCall) inst->profMaxCall = cycles;
+    if (perFrame < inst->profMinFrame) inst->profMinFrame = perFrame;
+    if (perFrame > inst->profMaxFrame) inst->profMaxFrame = perFrame;
+    inst->profCalls  += 1;
+    inst->profFrames += numFrames;
+    inst->profCycles += cycles;
+
+    // Publish roughly once per second of audio, then start a new window.
+    if (inst->profFrames < NT_globals.sampleRate) return;
+    inst->dispMinCall  = inst->profMinCall;
+    inst->dispAvgCall  = static_cast<uint32_t>(inst->profCycles / inst->profCalls);
+    inst->dispMaxCall  = inst->profMaxCall;
+    inst->dispMinFrame = inst->profMinFrame;
+    inst->dispAvgFrame = static_cast<float>(inst->profCycles) / static_cast<float>(inst->profFrames);
+    inst->dispMaxFrame = inst->profMaxFrame;
+    inst->profCalls = 0; inst->profFrames = 0; inst->profCycles = 0;
+    inst->profMinCall = UINT32_MAX; inst->profMaxCall = 0;
+    inst->profMinFrame = 1e30f; inst->profMaxFrame = 0.0f;
+}
 
-        // No culling: always draw
-        float Iout = (seg.draw ? 5.0f : 0.0f);
-        if (seg.draw && ((fShift < blankFrac) || (fShift > (1.0f - blankFrac)))) {
-            Iout = 0.0f;
-        }
+static void drawProfileLine(int y, const char* label, float a, float b, float c, int decimals) {
+    char buf[64];
+    int n = 0;
+    n += NT_floatToString(buf + n, a, decimals); buf[n++] = ' ';
+    n += NT_floatToString(buf + n, b, decimals); buf[n++] = ' ';
+    n += NT_floatToString(buf + n, c, decimals);
+    buf[n] = 0;
+    NT_drawText(0, y, label);
+    NT_drawText(96, y, buf);
+}
 
-        float outX = Xv * ampMul;
-        float outY = Yv * ampMul;
-        busX[i] = outX;
-        busY[i] = outY;
-        busI[i] = Iout;
-    }
-    inst->phase     = phase;
-    inst->ampPhase  = ampPhase;
+bool draw(_NT_algorithm* baseSelf) {
+    PolyInstance* inst = reinterpret_cast<PolyInstance*>(baseSelf);
+    NT_drawText(96, 20, "min avg max", 8);
+    drawProfileLine(32, "cyc/call",
+                    static_cast<float>(inst->dispMinCall),
+                    static_cast<float>(inst->dispAvgCall),
+                    static_cast<float>(inst->dispMaxCall), 0);
+    drawProfileLine(44, "cyc/frame",
+                    inst->dispMinFrame, inst->dispAvgFrame, inst->dispMaxFrame, 1);
+    return false;
 }
 
+#endif // POLY_PROFILE
+
 //—-----------------------------------------------------------------------------------------------
-// 13) Factory Definition & pluginEntry
+// 14) Factory Definition & pluginEntry
 //—-----------------------------------------------------------------------------------------------
 
+static const _NT_specification specifications[] = {
+    { .name = "Shape",   .min = 0, .max = kNumShapes - 1, .def = kShapeCube, .type = kNT_typeGeneric },
+    { .name = "Objects", .min = 1, .max = kMaxObjects,    .def = 1,          .type = kNT_typeGeneric },
+};
+
 static const _NT_factory polyFactory = {
     .guid                        = NT_MULTICHAR('P','O','L','Y'),
     .name                        = "CubeWireNoCull",
-    .description                 = "Wireframe cube (no culling)",
-    .numSpecifications           = 0,
-    .specifications              = nullptr,
+    .description                 = "Wireframe mesh scene with optional back-face culling",
+    .numSpecifications           = sizeof(specifications) / sizeof(specifications[0]),
+    .specifications              = specifications,
     .calculateStaticRequirements = calculateStaticRequirements,
     .initialise                  = initialise,
     .calculateRequirements       = calculateRequirements,
     .construct                   = constructAlgorithm,
     .parameterChanged            = parameterChanged,
     .step                        = step,
+#if POLY_PROFILE
+    .draw                        = draw,
+#else
     .draw                        = nullptr,
+#endif
     .midiRealtime                = nullptr,
     .midiMessage                 = nullptr,
     .tags                        = kNT_tagUtility,